@@ -0,0 +1,1205 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "Advisor.hpp"
+#include "Board.hpp"
+#include "ConstraintMatrix.hpp"
+#include "HintWorker.hpp"
+#include "HugePageAllocator.hpp"
+#include "Layout.hpp"
+#include "NdBoard.hpp"
+#include "ProbabilitySolver.hpp"
+#include "Solver.hpp"
+#include "SparseBoard.hpp"
+#include "Topology.hpp"
+#include "TranspositionTable.hpp"
+
+namespace {
+    using benchClock = std::chrono::steady_clock;
+
+    void report(const std::string_view name, const benchClock::duration elapsed, const std::uint64_t operations,
+                const std::string_view unit) {
+        const double nanoseconds{std::chrono::duration<double, std::nano>(elapsed).count()};
+        std::cout << std::left << std::setw(60) << name << std::right << std::setw(12) << std::fixed
+                << std::setprecision(2) << nanoseconds / static_cast<double>(operations) << " ns/" << unit << "\n";
+    }
+
+    // Counts last level cache misses through perf_event_open, in this thread and in every thread it starts while
+    // the counter is open, so one opened before a board is created also counts the board's reveal workers. Reads
+    // nothing off Linux or where the kernel won't hand hardware counters to user space, as in most virtual machines.
+    class CacheMissCounter final {
+        int m_descriptor{-1};
+
+    public:
+        CacheMissCounter() {
+            #ifdef __linux__
+            perf_event_attr attributes{};
+            attributes.size = sizeof(attributes);
+            attributes.type = PERF_TYPE_HARDWARE;
+            attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+            attributes.disabled = 1;
+            attributes.inherit = 1;
+            attributes.exclude_kernel = 1;
+            attributes.exclude_hv = 1;
+            m_descriptor = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+            #endif
+        }
+
+        CacheMissCounter(const CacheMissCounter&) = delete;
+        CacheMissCounter& operator=(const CacheMissCounter&) = delete;
+
+        ~CacheMissCounter() {
+            #ifdef __linux__
+            if (m_descriptor >= 0) {
+                close(m_descriptor);
+            }
+            #endif
+        }
+
+        // enabling and disabling reach the counters the started threads inherited as well
+        void start() const noexcept {
+            #ifdef __linux__
+            if (m_descriptor >= 0) {
+                ioctl(m_descriptor, PERF_EVENT_IOC_ENABLE, 0);
+            }
+            #endif
+        }
+
+        void stop() const noexcept {
+            #ifdef __linux__
+            if (m_descriptor >= 0) {
+                ioctl(m_descriptor, PERF_EVENT_IOC_DISABLE, 0);
+            }
+            #endif
+        }
+
+        [[nodiscard]] std::optional<std::uint64_t> read() const noexcept {
+            #ifdef __linux__
+            std::uint64_t misses{0};
+            if (m_descriptor >= 0 && ::read(m_descriptor, &misses, sizeof(misses)) == sizeof(misses)) {
+                return misses;
+            }
+            #endif
+            return std::nullopt;
+        }
+    };
+
+    // the neighbourhood loop Board used before topologies became a policy, kept as the baseline
+    template<typename Function>
+    void referenceForEachNeighbour(const std::uint8_t rowAmount, const std::uint8_t columnAmount,
+                                   const std::uint8_t row, const std::uint8_t column, Function&& function) {
+        for (std::int_fast8_t r{-1}; r <= 1; r++) {
+            if (r + row < 0 || r + row >= rowAmount) {
+                continue;
+            }
+            for (std::int_fast8_t c{-1}; c <= 1; c++) {
+                if (c + column < 0 || c + column >= columnAmount) {
+                    continue;
+                }
+                if (c == 0 && r == 0) {
+                    continue;
+                }
+                function(row + r, column + c);
+            }
+        }
+    }
+
+    template<bool UseReference>
+    void benchmarkNeighbourhood(const std::string_view name) {
+        constexpr std::uint8_t side{255};
+        constexpr int repetitions{200};
+        std::uint64_t checksum{0};
+        const benchClock::time_point start{benchClock::now()};
+        for (int i{0}; i < repetitions; i++) {
+            for (std::uint_fast8_t row{0}; row < side; row++) {
+                for (std::uint_fast8_t col{0}; col < side; col++) {
+                    auto accumulate = [&](const std::uint8_t r, const std::uint8_t c) {
+                        checksum += r ^ c;
+                    };
+                    if constexpr (UseReference) {
+                        referenceForEachNeighbour(side, side, row, col, accumulate);
+                    } else {
+                        Minesweeper::RectangularTopology::forEachNeighbour(side, side, row, col, accumulate);
+                    }
+                }
+            }
+        }
+        const benchClock::duration elapsed{benchClock::now() - start};
+        report(name, elapsed, static_cast<std::uint64_t>(repetitions) * side * side, "tile");
+        std::cout << "    checksum " << checksum << "\n";
+    }
+
+    template<typename Board>
+    void benchmarkGames(const std::string_view name) {
+        constexpr int games{2000};
+        benchClock::duration elapsed{};
+        std::uint64_t threeBVTotal{0};
+        for (int game{0}; game < games; game++) {
+            Board board{16, 30, 99};
+            board.setSeed(game);
+            const benchClock::time_point start{benchClock::now()};
+            board.checkTile(8, 15);
+            threeBVTotal += board.computeMetrics().threeBV;
+            elapsed += benchClock::now() - start;
+        }
+        report(name, elapsed, games, "game");
+        std::cout << "    mean 3BV " << static_cast<double>(threeBVTotal) / games << "\n";
+    }
+
+    template<typename Storage, typename Topology>
+    void benchmarkRevealPolicies(const std::string_view name) {
+        using Minesweeper::BasicBoard, Minesweeper::ParallelReveal, Minesweeper::SequentialReveal;
+        benchmarkGames<BasicBoard<Storage, Topology, ParallelReveal> >(std::string(name) + ", ParallelReveal");
+        benchmarkGames<BasicBoard<Storage, Topology, SequentialReveal> >(std::string(name) + ", SequentialReveal");
+    }
+
+    template<typename Storage>
+    void benchmarkTopologies(const std::string_view name) {
+        benchmarkRevealPolicies<Storage, Minesweeper::RectangularTopology>(std::string(name) + ", Rectangular");
+        benchmarkRevealPolicies<Storage, Minesweeper::TorusTopology>(std::string(name) + ", Torus");
+        benchmarkRevealPolicies<Storage, Minesweeper::HexagonalTopology>(std::string(name) + ", Hexagonal");
+        benchmarkRevealPolicies<Storage, Minesweeper::KnightTopology>(std::string(name) + ", Knight");
+    }
+
+    // a sparse 255 x 255 board opens almost entirely from the first click, so the flood fill steps between rows about
+    // as often as along them. Walled in by two columns of flags, the opening is instead a corridor 16 tiles wide
+    // running the height of the board, where most steps are vertical and a row-major layout moves a whole row away
+    template<typename Layout>
+    void benchmarkLayout(const std::string_view name, const bool corridor) {
+        constexpr int games{20};
+        benchClock::duration elapsed{};
+        std::uint64_t checkedTotal{0};
+        std::uint64_t openingTotal{0};
+        std::optional<std::uint64_t> missTotal{0};
+        for (int game{0}; game < games; game++) {
+            const CacheMissCounter misses;
+            Minesweeper::BasicBoard<Minesweeper::VectorStorage<Layout>, Minesweeper::RectangularTopology,
+                                    Minesweeper::ParallelReveal> board{255, 255, 300};
+            board.setSeed(game);
+            if (corridor) {
+                for (std::uint8_t row{0}; row < 255; row++) {
+                    board.toggleFlag(row, 119);
+                    board.toggleFlag(row, 136);
+                }
+            }
+            misses.start();
+            const benchClock::time_point start{benchClock::now()};
+            board.checkTile(127, 127);
+            openingTotal += board.computeMetrics().openings;
+            elapsed += benchClock::now() - start;
+            misses.stop();
+            checkedTotal += 255 * 255 - board.getUncheckedAmount();
+            const std::optional<std::uint64_t> counted{misses.read()};
+            missTotal = missTotal.has_value() && counted.has_value()
+                            ? std::optional<std::uint64_t>{*missTotal + *counted}
+                            : std::nullopt;
+        }
+        report(name, elapsed, games, "game");
+        std::cout << "    mean tiles opened " << static_cast<double>(checkedTotal) / games << ", mean openings "
+                << static_cast<double>(openingTotal) / games << ", ";
+        if (missTotal.has_value()) {
+            std::cout << "mean cache misses " << static_cast<double>(*missTotal) / games << "\n";
+        } else {
+            std::cout << "cache misses not counted here\n";
+        }
+    }
+
+    // the first click on a board with few mines opens most of it, which is where the dilation engine should win
+    void benchmarkRevealEngine(const Minesweeper::RevealEngine engine, const std::uint16_t mineCount,
+                               const std::string_view name) {
+        constexpr int games{50};
+        benchClock::duration elapsed{};
+        for (int game{0}; game < games; game++) {
+            Minesweeper::Board board{255, 255, mineCount, Minesweeper::CountMode::eager, engine};
+            board.setSeed(game);
+            const benchClock::time_point start{benchClock::now()};
+            board.checkTile(127, 127);
+            elapsed += benchClock::now() - start;
+        }
+        report(name, elapsed, games, "game");
+    }
+
+    // flags every mine after the first click, then times one chordAll opening the rest of the board
+    void benchmarkChordAll(const std::uint16_t mineCount, const std::string_view name) {
+        constexpr int games{20};
+        benchClock::duration elapsed{};
+        std::size_t revealed{0};
+        for (int game{0}; game < games; game++) {
+            Minesweeper::Board board{255, 255, mineCount};
+            board.setSeed(game);
+            board.checkTile(127, 127);
+            for (std::uint_fast8_t row{0}; row < 255; row++) {
+                for (std::uint_fast8_t col{0}; col < 255; col++) {
+                    if (board.atCoordinate(row, col).isMine()) {
+                        board.toggleFlag(row, col);
+                    }
+                }
+            }
+            const benchClock::time_point start{benchClock::now()};
+            revealed += board.chordAll();
+            elapsed += benchClock::now() - start;
+        }
+        report(name, elapsed, games, "sweep");
+        report(std::string{name} + ", per revealed tile", elapsed, revealed, "tile");
+    }
+
+    // random rectangles on a half-revealed 255 x 255 board, through the Fenwick trees or by scanning the tiles
+    template<bool Scan>
+    void benchmarkRegionCounts(const std::string_view name) {
+        constexpr int queries{200'000};
+        Minesweeper::Board board{255, 255, 3000};
+        board.setSeed(0);
+        board.checkTile(127, 127);
+        std::mt19937 generator{0};
+        std::uniform_int_distribution<int> coordinate{0, 254};
+        std::uint64_t checksum{0};
+        const benchClock::time_point start{benchClock::now()};
+        for (int query{0}; query < queries; query++) {
+            const int rowA{coordinate(generator)};
+            const int rowB{coordinate(generator)};
+            const int columnA{coordinate(generator)};
+            const int columnB{coordinate(generator)};
+            const int firstRow{std::min(rowA, rowB)};
+            const int lastRow{std::max(rowA, rowB)};
+            const int firstColumn{std::min(columnA, columnB)};
+            const int lastColumn{std::max(columnA, columnB)};
+            if constexpr (Scan) {
+                for (int row{firstRow}; row <= lastRow; row++) {
+                    for (int column{firstColumn}; column <= lastColumn; column++) {
+                        checksum += board.atCoordinate(row, column).isChecked();
+                    }
+                }
+            } else {
+                checksum += board.countRegion(static_cast<std::uint8_t>(firstRow),
+                                              static_cast<std::uint8_t>(firstColumn),
+                                              static_cast<std::uint8_t>(lastRow),
+                                              static_cast<std::uint8_t>(lastColumn)).revealed;
+            }
+        }
+        const benchClock::duration elapsed{benchClock::now() - start};
+        report(std::string{name} + " (checksum " + std::to_string(checksum) + ")", elapsed, queries, "query");
+    }
+
+    // reveals random safe tiles of a 255 x 255 board and lists its frontier after every reveal, by scanning every
+    // tile's neighbourhood or through the set the board keeps up to date
+    template<bool Scan>
+    void benchmarkFrontier(const std::string_view name) {
+        constexpr int reveals{400};
+        Minesweeper::BasicBoard<Minesweeper::VectorStorage<>, Minesweeper::RectangularTopology,
+                                Minesweeper::SequentialReveal> board{255, 255, 9000};
+        board.setSeed(0);
+        board.checkTile(127, 127);
+        std::mt19937 generator{0};
+        std::uniform_int_distribution<int> coordinate{0, 254};
+        std::uint64_t checksum{0};
+        benchClock::duration elapsed{};
+        for (int reveal{0}; reveal < reveals; reveal++) {
+            std::uint8_t row, column;
+            do {
+                row = static_cast<std::uint8_t>(coordinate(generator));
+                column = static_cast<std::uint8_t>(coordinate(generator));
+            } while (board.atCoordinate(row, column).isMine());
+            const benchClock::time_point start{benchClock::now()};
+            board.checkTile(row, column);
+            if constexpr (Scan) {
+                for (std::uint_fast8_t r{0}; r < 255; r++) {
+                    for (std::uint_fast8_t c{0}; c < 255; c++) {
+                        const Minesweeper::Tile& tile{board.atCoordinate(r, c)};
+                        if (tile.isChecked() || tile.isFlagged()) {
+                            continue;
+                        }
+                        bool nextToNumber{false};
+                        Minesweeper::RectangularTopology::forEachNeighbour(255, 255, r, c, [&](const std::uint8_t nr,
+                                                                                               const std::uint8_t nc) {
+                            const Minesweeper::Tile& neighbour{board.atCoordinate(nr, nc)};
+                            nextToNumber = nextToNumber
+                                           || (neighbour.isChecked() && neighbour.getSurroundingMines() != 0);
+                        });
+                        checksum += nextToNumber ? r * 255 + c : 0;
+                    }
+                }
+            } else {
+                for (const std::uint16_t index: board.getFrontier().tiles()) {
+                    checksum += index;
+                }
+            }
+            elapsed += benchClock::now() - start;
+        }
+        report(std::string{name} + " (checksum " + std::to_string(checksum) + ")", elapsed, reveals, "move");
+    }
+
+    // plays the same seeded games with both engines, revealing every safe tile the threaded board still has hidden,
+    // and compares every tile after each move; returns the games that differ
+    template<typename Topology>
+    int crossCheckRevealEngines(const std::string_view name) {
+        constexpr int games{50};
+        int mismatches{0};
+        for (int game{0}; game < games; game++) {
+            const auto mineCount{static_cast<std::uint16_t>(200 + game * 40)};
+            using Board = Minesweeper::BasicBoard<Minesweeper::VectorStorage<>, Topology, Minesweeper::ParallelReveal>;
+            Board threaded{64, 200, mineCount};
+            Board dilation{
+                64, 200, mineCount, Minesweeper::CountMode::eager, Minesweeper::RevealEngine::bitParallel
+            };
+            threaded.setSeed(game);
+            dilation.setSeed(game);
+            threaded.checkTile(32, 100);
+            dilation.checkTile(32, 100);
+            bool matching{threaded.getUncheckedAmount() == dilation.getUncheckedAmount()};
+            for (std::uint8_t row{0}; row < 64 && matching; row++) {
+                for (std::uint8_t column{0}; column < 200 && matching; column++) {
+                    if (threaded.atCoordinate(row, column).isChecked() || threaded.atCoordinate(row, column).isMine()) {
+                        continue;
+                    }
+                    threaded.checkTile(row, column);
+                    dilation.checkTile(row, column);
+                    matching = threaded.getUncheckedAmount() == dilation.getUncheckedAmount();
+                }
+            }
+            for (std::uint8_t row{0}; row < 64 && matching; row++) {
+                for (std::uint8_t column{0}; column < 200 && matching; column++) {
+                    matching = threaded.atCoordinate(row, column).isChecked()
+                               == dilation.atCoordinate(row, column).isChecked();
+                }
+            }
+            mismatches += !matching;
+        }
+        std::cout << std::left << std::setw(60) << name << std::right << std::setw(12) << games - mismatches << " of "
+                << games << " games agree\n";
+        return mismatches;
+    }
+
+    void benchmarkVolume(const std::uint32_t mineCount) {
+        constexpr int volumes{5};
+        benchClock::duration elapsed{};
+        for (int volume{0}; volume < volumes; volume++) {
+            Minesweeper::VolumeBoard board{{256, 256, 256}, mineCount};
+            board.setSeed(volume);
+            const benchClock::time_point start{benchClock::now()};
+            board.checkTile({128, 128, 128});
+            elapsed += benchClock::now() - start;
+        }
+        report(std::to_string(mineCount) + " mines", elapsed, volumes, "volume");
+    }
+
+    // generation and flood fill walk the planes in order, while the random reveals afterwards jump across all
+    // 16 million tiles and mostly pay for TLB misses
+    void benchmarkHugePages(const Minesweeper::HugePageMode mode, const std::string_view name) {
+        constexpr std::uint16_t side{4096};
+        constexpr int boards{3};
+        constexpr int reveals{200'000};
+        Minesweeper::setHugePageMode(mode);
+        benchClock::duration firstClick{};
+        benchClock::duration randomReveals{};
+        for (int game{0}; game < boards; game++) {
+            Minesweeper::NdBoard<2> board{{side, side}, side * side / 8};
+            board.setSeed(game);
+            benchClock::time_point start{benchClock::now()};
+            board.checkTile({side / 2, side / 2});
+            firstClick += benchClock::now() - start;
+            std::mt19937 rng{static_cast<std::mt19937::result_type>(game)};
+            std::uniform_int_distribution<std::uint16_t> coordinate(0, side - 1);
+            start = benchClock::now();
+            for (int reveal{0}; reveal < reveals; reveal++) {
+                const Minesweeper::NdBoard<2>::Coordinates tile{coordinate(rng), coordinate(rng)};
+                if (!board.isMine(tile)) {
+                    board.checkTile(tile);
+                }
+            }
+            randomReveals += benchClock::now() - start;
+        }
+        report(std::string(name) + ", first click", firstClick, boards, "board");
+        report(std::string(name) + ", random reveals", randomReveals, static_cast<std::uint64_t>(boards) * reveals,
+               "reveal");
+    }
+
+    // single reveals away from any opening only touch the summary blocks around them, so the time per move should
+    // stay flat as the board grows
+    void benchmarkSummaries(const std::uint16_t side) {
+        constexpr int reveals{100'000};
+        Minesweeper::NdBoard<2> board{{side, side}, static_cast<std::uint32_t>(side * side / 4)};
+        board.setSeed(side);
+        board.checkTile({static_cast<std::uint16_t>(side / 2), static_cast<std::uint16_t>(side / 2)});
+        std::mt19937 rng{side};
+        std::uniform_int_distribution<std::uint16_t> coordinate(0, side - 1);
+        const benchClock::time_point start{benchClock::now()};
+        for (int reveal{0}; reveal < reveals; reveal++) {
+            const Minesweeper::NdBoard<2>::Coordinates tile{coordinate(rng), coordinate(rng)};
+            if (!board.isMine(tile)) {
+                board.checkTile(tile);
+            }
+        }
+        report(std::to_string(side) + " x " + std::to_string(side), benchClock::now() - start, reveals, "move");
+        std::size_t frontierBlocks{0};
+        board.forEachFrontierBlock([&](std::size_t) { frontierBlocks++; });
+        std::cout << "    " << board.getAllRevealedBlockAmount() << " resolved and " << frontierBlocks
+                << " frontier blocks of " << board.getBlockAmount() << "\n";
+    }
+
+    // generates a giant low-density board without opening it (the first click is fenced in by flags), then times
+    // count queries at random tiles
+    void benchmarkSparseQueries(const std::uint32_t side, const std::uint64_t mineCount) {
+        constexpr int queries{1'000'000};
+        Minesweeper::SparseBoard board{side, side, mineCount};
+        board.setSeed(side);
+        const std::uint32_t centre{side / 2};
+        for (std::uint32_t row{centre - 1}; row <= centre + 1; row++) {
+            for (std::uint32_t column{centre - 1}; column <= centre + 1; column++) {
+                if (row != centre || column != centre) {
+                    board.toggleFlag(row, column);
+                }
+            }
+        }
+        const benchClock::time_point generationStart{benchClock::now()};
+        board.checkTile(centre, centre);
+        const std::string name{std::to_string(side) + " x " + std::to_string(side) + ", " + std::to_string(mineCount)};
+        report(name + " mines, generation", benchClock::now() - generationStart, mineCount, "mine");
+        std::mt19937 rng{side};
+        std::uniform_int_distribution<std::uint32_t> coordinate(0, side - 1);
+        std::uint64_t checksum{0};
+        const benchClock::time_point start{benchClock::now()};
+        for (int query{0}; query < queries; query++) {
+            checksum += board.getSurroundingMines(coordinate(rng), coordinate(rng));
+        }
+        report(name + " mines, counts", benchClock::now() - start, queries, "query");
+        std::cout << "    " << board.memoryUsage() / 1024 << " KiB held, checksum " << checksum << "\n";
+    }
+
+    void benchmarkSparseOpening(const std::uint32_t side, const std::uint64_t mineCount,
+                                const std::size_t memoryBudget = 0) {
+        Minesweeper::SparseBoard board{side, side, mineCount, {memoryBudget}};
+        board.setSeed(side);
+        const benchClock::time_point start{benchClock::now()};
+        board.checkTile(side / 2, side / 2);
+        std::string name{std::to_string(side) + " x " + std::to_string(side) + ", " + std::to_string(mineCount)};
+        if (memoryBudget != 0) {
+            name += ", " + std::to_string(memoryBudget >> 10) + " KiB budget";
+        }
+        report(name + ", first click", benchClock::now() - start, board.getCheckedAmount(), "tile");
+        std::cout << "    " << board.getCheckedAmount() << " tiles revealed, " << board.memoryUsage() / 1024
+                << " KiB held, " << board.getCheckedChunks().getSpilledAmount() << " chunks spilled\n";
+    }
+
+    // plays the same random games on a sparse board that keeps every chunk and on one that pages all but a few out:
+    // clicks on safe tiles, flags on mines, and chords around revealed numbers once their mines are flagged. Both have
+    // to reveal the same tiles after every move and show the same revealed and flagged tiles at the end; returns the
+    // games that differ
+    int crossCheckSparseBudget(const int games, const std::size_t memoryBudget) {
+        constexpr std::uint32_t side{512};
+        constexpr std::uint64_t mineCount{2'621};
+        constexpr int moves{200};
+        int mismatches{0};
+        std::size_t spilled{0};
+        std::uint64_t spillBytes{0};
+        for (int game{0}; game < games; game++) {
+            Minesweeper::SparseBoard kept{side, side, mineCount};
+            Minesweeper::SparseBoard paged{side, side, mineCount, {memoryBudget}};
+            kept.setSeed(game);
+            paged.setSeed(game);
+            kept.checkTile(side / 2, side / 2);
+            paged.checkTile(side / 2, side / 2);
+            std::mt19937_64 rng{static_cast<std::uint64_t>(game)};
+            std::uniform_int_distribution<std::uint32_t> coordinate{0, side - 1};
+            bool matching{kept.getCheckedAmount() == paged.getCheckedAmount()};
+            for (int move{0}; move < moves && matching; move++) {
+                const std::uint32_t row{coordinate(rng)};
+                const std::uint32_t column{coordinate(rng)};
+                if (kept.isMine(row, column)) {
+                    kept.toggleFlag(row, column);
+                    paged.toggleFlag(row, column);
+                } else if (kept.isChecked(row, column)) {
+                    for (std::int64_t r{std::int64_t{row} - 1}; r <= std::int64_t{row} + 1; r++) {
+                        for (std::int64_t c{std::int64_t{column} - 1}; c <= std::int64_t{column} + 1; c++) {
+                            if (r < 0 || c < 0 || r >= side || c >= side) {
+                                continue;
+                            }
+                            const auto mineRow{static_cast<std::uint32_t>(r)};
+                            const auto mineColumn{static_cast<std::uint32_t>(c)};
+                            if (kept.isMine(mineRow, mineColumn) && !kept.isFlagged(mineRow, mineColumn)) {
+                                kept.toggleFlag(mineRow, mineColumn);
+                                paged.toggleFlag(mineRow, mineColumn);
+                            }
+                        }
+                    }
+                    kept.clearSafeTiles(row, column);
+                    paged.clearSafeTiles(row, column);
+                } else {
+                    kept.checkTile(row, column);
+                    paged.checkTile(row, column);
+                }
+                matching = kept.getCheckedAmount() == paged.getCheckedAmount();
+            }
+            for (std::uint32_t row{0}; row < side && matching; row++) {
+                for (std::uint32_t column{0}; column < side && matching; column++) {
+                    matching = kept.isChecked(row, column) == paged.isChecked(row, column)
+                               && kept.isFlagged(row, column) == paged.isFlagged(row, column);
+                }
+            }
+            mismatches += !matching;
+            spilled += paged.getCheckedChunks().getSpilledAmount() + paged.getFlaggedChunks().getSpilledAmount();
+            spillBytes += paged.getCheckedChunks().getFileSize() + paged.getFlaggedChunks().getFileSize();
+        }
+        std::cout << std::left << std::setw(60)
+                << std::to_string(side) + " x " + std::to_string(side) + ", " + std::to_string(mineCount) + ", "
+                   + std::to_string(memoryBudget >> 10) + " KiB budget against none" << std::right << std::setw(12)
+                << games - mismatches << " of " << games << " games agree\n";
+        std::cout << "    " << spilled / games << " chunks spilled a game in " << spillBytes / games / 1024
+                << " KiB of spill file\n";
+        return mismatches;
+    }
+
+    // expert games played by the solver, guessing the first hidden tile it can't settle; the solver is fed through
+    // reveal/flag rather than observe(), so the time is the deductions alone
+    void benchmarkSolver(const int games) {
+        using SequentialBoard = Minesweeper::BasicBoard<Minesweeper::VectorStorage<>, Minesweeper::RectangularTopology,
+                                                        Minesweeper::SequentialReveal>;
+        benchClock::duration elapsed{};
+        std::size_t deductions{0};
+        int wins{0};
+        Minesweeper::Solver solver{16, 30};
+        for (int game{0}; game < games; game++) {
+            SequentialBoard board{16, 30, 99};
+            board.setSeed(game);
+            solver.reset();
+            Minesweeper::TileCoordinates next{8, 15};
+            while (!board.hitMine() && !board.foundAllMines()) {
+                board.checkTile(next.first, next.second);
+                for (std::uint8_t row{0}; row < 16; row++) {
+                    for (std::uint8_t column{0}; column < 30; column++) {
+                        const Minesweeper::Tile& tile{board.atCoordinate(row, column)};
+                        if (tile.isChecked() && solver.viewAt(row, column) == Minesweeper::Solver::hidden) {
+                            solver.reveal(row, column, tile.getSurroundingMines());
+                        }
+                    }
+                }
+                const benchClock::time_point start{benchClock::now()};
+                deductions += solver.solve();
+                elapsed += benchClock::now() - start;
+                if (const std::optional<Minesweeper::TileCoordinates> safe{solver.nextSafeTile()}) {
+                    next = *safe;
+                    continue;
+                }
+                for (std::uint16_t index{0}; index < 16 * 30; index++) {
+                    const std::uint8_t row{static_cast<std::uint8_t>(index / 30)};
+                    const std::uint8_t column{static_cast<std::uint8_t>(index % 30)};
+                    if (solver.viewAt(row, column) == Minesweeper::Solver::hidden && !solver.isKnownMine(row, column)) {
+                        next = {row, column};
+                        break;
+                    }
+                }
+            }
+            wins += board.foundAllMines();
+        }
+        report("expert, " + std::to_string(wins) + "/" + std::to_string(games) + " won", elapsed, deductions,
+               "deduction");
+    }
+
+    // expert games that guess the safest tile whenever the deterministic rules run out; the time is the exact
+    // probabilities of each guess
+    void benchmarkProbabilities(const int games) {
+        using SequentialBoard = Minesweeper::BasicBoard<Minesweeper::VectorStorage<>, Minesweeper::RectangularTopology,
+                                                        Minesweeper::SequentialReveal>;
+        benchClock::duration elapsed{};
+        benchClock::duration slowest{};
+        std::size_t decisions{0};
+        std::size_t forced{0};
+        int wins{0};
+        Minesweeper::Solver solver{16, 30};
+        Minesweeper::ProbabilitySolver probabilities{};
+        for (int game{0}; game < games; game++) {
+            SequentialBoard board{16, 30, 99};
+            board.setSeed(game);
+            solver.reset();
+            Minesweeper::TileCoordinates next{8, 15};
+            while (!board.hitMine() && !board.foundAllMines()) {
+                board.checkTile(next.first, next.second);
+                solver.observe(board);
+                solver.solve();
+                if (const std::optional<Minesweeper::TileCoordinates> safe{solver.nextSafeTile()}) {
+                    next = *safe;
+                    continue;
+                }
+                const benchClock::time_point start{benchClock::now()};
+                if (!probabilities.compute(solver, 99)) {
+                    break;
+                }
+                const benchClock::duration decision{benchClock::now() - start};
+                elapsed += decision;
+                slowest = std::max(slowest, decision);
+                decisions++;
+                forced += probabilities.getForcedAmount();
+                if (const std::optional<Minesweeper::TileCoordinates> guess{probabilities.safestTile(solver)}) {
+                    next = *guess;
+                }
+            }
+            wins += board.foundAllMines();
+        }
+        report("expert, " + std::to_string(wins) + "/" + std::to_string(games) + " won", elapsed, decisions,
+               "decision");
+        report("expert, slowest decision", slowest, 1, "decision");
+        std::cout << forced << " tiles settled by parity elimination over " << decisions << " decisions\n";
+    }
+
+    // the deductions and probabilities brought up to date after every move of expert games, once by solving the
+    // board from scratch, without and with a transposition table, and once by feeding the move's change list to the
+    // solvers
+    void benchmarkIncremental(const int games) {
+        using RecordedBoard = Minesweeper::BasicBoard<Minesweeper::VectorStorage<>, Minesweeper::RectangularTopology,
+                                                      Minesweeper::SequentialReveal, Minesweeper::ChangeRecorder>;
+        benchClock::duration fromScratch{};
+        benchClock::duration fromChanges{};
+        benchClock::duration withTable{};
+        std::size_t moves{0};
+        Minesweeper::Solver scratchSolver{16, 30};
+        Minesweeper::Solver solver{16, 30};
+        Minesweeper::ProbabilitySolver scratchProbabilities{};
+        Minesweeper::ProbabilitySolver probabilities{};
+        Minesweeper::ProbabilitySolver tableProbabilities{nullptr, std::make_shared<Minesweeper::TranspositionTable>()};
+        for (int game{0}; game < games; game++) {
+            RecordedBoard board{16, 30, 99};
+            board.setSeed(game);
+            solver.reset();
+            std::size_t seen{0};
+            Minesweeper::TileCoordinates next{8, 15};
+            while (!board.hitMine() && !board.foundAllMines()) {
+                board.checkTile(next.first, next.second);
+                if (board.hitMine()) {
+                    break;
+                }
+                const std::vector<Minesweeper::TileChange>& recorded{board.getObserver().getChanges()};
+                const std::span<const Minesweeper::TileChange> changes{std::span{recorded}.subspan(seen)};
+                seen = recorded.size();
+
+                benchClock::time_point start{benchClock::now()};
+                scratchSolver.reset();
+                scratchSolver.observe(board);
+                scratchSolver.solve();
+                const benchClock::duration solving{benchClock::now() - start};
+                bool consistent{scratchProbabilities.compute(scratchSolver, 99)};
+                fromScratch += benchClock::now() - start;
+
+                start = benchClock::now();
+                consistent &= tableProbabilities.compute(scratchSolver, 99);
+                withTable += benchClock::now() - start + solving;
+
+                start = benchClock::now();
+                solver.observe(board, changes);
+                solver.solve();
+                probabilities.invalidate(changes);
+                // a new game is not a change list away from the last one
+                consistent &= seen == changes.size() ? probabilities.compute(solver, 99)
+                                                     : probabilities.update(solver, 99);
+                fromChanges += benchClock::now() - start;
+                if (!consistent) {
+                    break;
+                }
+                moves++;
+                if (const std::optional<Minesweeper::TileCoordinates> safe{solver.nextSafeTile()}) {
+                    next = *safe;
+                } else if (const std::optional<Minesweeper::TileCoordinates> guess{
+                    probabilities.safestTile(solver)
+                }) {
+                    next = *guess;
+                }
+            }
+        }
+        report("expert, from scratch", fromScratch, moves, "move");
+        report("expert, from scratch with a transposition table", withTable, moves, "move");
+        report("expert, from the change lists", fromChanges, moves, "move");
+        const Minesweeper::ProbabilitySolver::Stats stats{tableProbabilities.getStats()};
+        std::cout << stats.hits << "/" << stats.lookups << " components found in a table of "
+                << stats.tableBytes / 1024 << " KiB\n";
+    }
+
+    // Every layout of the mines over a small board's hidden tiles, found by backtracking over the tiles in order with
+    // nothing but the revealed numbers to prune on, gives each hidden tile's exact probability. Random games on
+    // 5 x 7 boards are played to the end, and after every move the probabilities from scratch, from the move's
+    // change list and through a transposition table must all agree with the count within 1e-9.
+    int crossCheckProbabilities(const int games) {
+        using RecordedBoard = Minesweeper::BasicBoard<Minesweeper::VectorStorage<>, Minesweeper::RectangularTopology,
+                                                      Minesweeper::SequentialReveal, Minesweeper::ChangeRecorder>;
+        constexpr std::uint8_t rows{5};
+        constexpr std::uint8_t columns{7};
+        constexpr std::size_t size{rows * columns};
+        struct Number {
+            std::uint8_t target;
+            std::uint8_t mines;
+            std::uint8_t open; // the hidden neighbours not assigned yet
+        };
+        std::vector<Number> numbers;
+        std::vector<std::vector<std::size_t>> numbersAt(size); // the numbers each hidden tile is next to
+        std::vector<std::uint16_t> hidden;
+        std::vector<std::uint8_t> layout(size);
+        std::vector<double> layoutsWithMine(size);
+        double layoutAmount{0.0};
+        auto place = [&](auto& self, const std::size_t next, const std::size_t minesLeft) -> void {
+            if (minesLeft > hidden.size() - next) {
+                return;
+            }
+            if (next == hidden.size()) {
+                layoutAmount += 1.0;
+                for (const std::uint16_t tile: hidden) {
+                    layoutsWithMine[tile] += layout[tile];
+                }
+                return;
+            }
+            const std::uint16_t tile{hidden[next]};
+            for (const bool mine: {false, true}) {
+                if (mine && minesLeft == 0) {
+                    continue;
+                }
+                bool fits{true};
+                for (const std::size_t number: numbersAt[tile]) {
+                    numbers[number].open--;
+                    numbers[number].mines += mine;
+                    fits &= numbers[number].mines <= numbers[number].target
+                            && numbers[number].mines + numbers[number].open >= numbers[number].target;
+                }
+                if (fits) {
+                    layout[tile] = mine;
+                    self(self, next + 1, minesLeft - mine);
+                }
+                for (const std::size_t number: numbersAt[tile]) {
+                    numbers[number].open++;
+                    numbers[number].mines -= mine;
+                }
+            }
+            layout[tile] = 0;
+        };
+
+        int mismatches{0};
+        std::size_t positions{0};
+        std::mt19937_64 rng{0};
+        Minesweeper::Solver scratchSolver{rows, columns};
+        Minesweeper::Solver solver{rows, columns};
+        Minesweeper::ProbabilitySolver scratchProbabilities{};
+        Minesweeper::ProbabilitySolver probabilities{};
+        Minesweeper::ProbabilitySolver tableProbabilities{nullptr, std::make_shared<Minesweeper::TranspositionTable>()};
+        for (int game{0}; game < games; game++) {
+            const auto mineCount{static_cast<std::uint16_t>(5 + game % 4)};
+            RecordedBoard board{rows, columns, mineCount};
+            board.setSeed(game);
+            solver.reset();
+            std::size_t seen{0};
+            Minesweeper::TileCoordinates next{rows / 2, columns / 2};
+            while (true) {
+                board.checkTile(next.first, next.second);
+                if (board.hitMine() || board.foundAllMines()) {
+                    break;
+                }
+                const std::vector<Minesweeper::TileChange>& recorded{board.getObserver().getChanges()};
+                const std::span<const Minesweeper::TileChange> changes{std::span{recorded}.subspan(seen)};
+                seen = recorded.size();
+
+                numbers.clear();
+                hidden.clear();
+                std::ranges::fill(layoutsWithMine, 0.0);
+                layoutAmount = 0.0;
+                for (std::uint16_t index{0}; index < size; index++) {
+                    numbersAt[index].clear();
+                    if (!board.atCoordinate(index / columns, index % columns).isChecked()) {
+                        hidden.push_back(index);
+                    }
+                }
+                for (std::uint16_t index{0}; index < size; index++) {
+                    const auto row{static_cast<std::uint8_t>(index / columns)};
+                    const auto column{static_cast<std::uint8_t>(index % columns)};
+                    const Minesweeper::Tile& tile{board.atCoordinate(row, column)};
+                    if (!tile.isChecked()) {
+                        continue;
+                    }
+                    Number number{tile.getSurroundingMines(), 0, 0};
+                    Minesweeper::RectangularTopology::forEachNeighbour(
+                        rows, columns, row, column, [&](const std::uint8_t r, const std::uint8_t c) {
+                            if (!board.atCoordinate(r, c).isChecked()) {
+                                numbersAt[r * columns + c].push_back(numbers.size());
+                                number.open++;
+                            }
+                        });
+                    numbers.push_back(number);
+                }
+                place(place, 0, mineCount);
+
+                scratchSolver.reset();
+                scratchSolver.observe(board);
+                scratchSolver.solve();
+                solver.observe(board, changes);
+                solver.solve();
+                probabilities.invalidate(changes);
+                bool matching{scratchProbabilities.compute(scratchSolver, mineCount)};
+                matching &= tableProbabilities.compute(scratchSolver, mineCount);
+                // a new game is not a change list away from the last one
+                matching &= seen == changes.size() ? probabilities.compute(solver, mineCount)
+                                                   : probabilities.update(solver, mineCount);
+                for (const std::uint16_t index: hidden) {
+                    const auto row{static_cast<std::uint8_t>(index / columns)};
+                    const auto column{static_cast<std::uint8_t>(index % columns)};
+                    const double exact{layoutsWithMine[index] / layoutAmount};
+                    for (const Minesweeper::ProbabilitySolver* solved: {
+                             &scratchProbabilities, &probabilities, &tableProbabilities
+                         }) {
+                        matching &= std::abs(solved->probabilityAt(row, column) - exact) < 1e-9;
+                    }
+                }
+                mismatches += !matching;
+                positions++;
+
+                // the solver's safe tiles first, then any hidden tile, so the games reach the awkward positions too
+                if (const std::optional<Minesweeper::TileCoordinates> safe{solver.nextSafeTile()}) {
+                    next = *safe;
+                } else {
+                    const std::uint16_t index{hidden[rng() % hidden.size()]};
+                    next = {static_cast<std::uint8_t>(index / columns), static_cast<std::uint8_t>(index % columns)};
+                }
+            }
+        }
+        std::cout << std::left << std::setw(60) << "5 x 7, from scratch, change lists and table" << std::right
+                << std::setw(12) << positions - mismatches << " of " << positions << " positions agree\n";
+        return mismatches;
+    }
+
+    // Layouts drawn with sampleLayout() at the guesses of expert games, where the deductions have run out: every
+    // layout has to put all the mines down, none on a revealed tile, and exactly each revealed number's worth next
+    // to it, and how often a tile holds a mine has to stay within six standard errors (and one draw) of its exact
+    // probability. Returns the positions that fail.
+    int crossCheckSampling(const int games, const int draws) {
+        using SequentialBoard = Minesweeper::BasicBoard<Minesweeper::VectorStorage<>, Minesweeper::RectangularTopology,
+                                                        Minesweeper::SequentialReveal>;
+        constexpr std::size_t size{16 * 30};
+        int mismatches{0};
+        std::size_t positions{0};
+        std::mt19937_64 generator{0};
+        std::vector<std::uint8_t> mines;
+        std::vector<int> drawnMines(size);
+        Minesweeper::Solver solver{16, 30};
+        Minesweeper::ProbabilitySolver probabilities{};
+        for (int game{0}; game < games; game++) {
+            SequentialBoard board{16, 30, 99};
+            board.setSeed(game);
+            solver.reset();
+            Minesweeper::TileCoordinates next{8, 15};
+            while (true) {
+                board.checkTile(next.first, next.second);
+                if (board.hitMine() || board.foundAllMines()) {
+                    break;
+                }
+                solver.observe(board);
+                solver.solve();
+                if (const std::optional<Minesweeper::TileCoordinates> safe{solver.nextSafeTile()}) {
+                    next = *safe;
+                    continue;
+                }
+                if (!probabilities.compute(solver, 99)) {
+                    break;
+                }
+                if (const std::optional<Minesweeper::TileCoordinates> guess{probabilities.safestTile(solver)}) {
+                    next = *guess;
+                }
+                if (!probabilities.prepareSampling()) {
+                    continue;
+                }
+                bool matching{true};
+                std::ranges::fill(drawnMines, 0);
+                for (int draw{0}; draw < draws; draw++) {
+                    probabilities.sampleLayout(generator, mines);
+                    matching &= std::ranges::count(mines, 1) == 99;
+                    for (std::uint16_t index{0}; index < size; index++) {
+                        drawnMines[index] += mines[index];
+                        const auto row{static_cast<std::uint8_t>(index / 30)};
+                        const auto column{static_cast<std::uint8_t>(index % 30)};
+                        const Minesweeper::Tile& tile{board.atCoordinate(row, column)};
+                        if (!tile.isChecked()) {
+                            continue;
+                        }
+                        std::uint8_t around{0};
+                        Minesweeper::RectangularTopology::forEachNeighbour(
+                            16, 30, row, column, [&](const std::uint8_t r, const std::uint8_t c) {
+                                around += mines[r * 30 + c];
+                            });
+                        matching &= mines[index] == 0 && around == tile.getSurroundingMines();
+                    }
+                }
+                for (std::uint16_t index{0}; index < size; index++) {
+                    const double exact{probabilities.probabilityAt(index / 30, index % 30)};
+                    const double frequency{static_cast<double>(drawnMines[index]) / draws};
+                    matching &= std::abs(frequency - exact) <= 6.0 * std::sqrt(exact * (1.0 - exact) / draws)
+                                                              + 1.0 / draws;
+                }
+                mismatches += !matching;
+                positions++;
+            }
+        }
+        std::cout << std::left << std::setw(60) << "expert, " + std::to_string(draws) + " layouts a position"
+                << std::right << std::setw(12) << positions - mismatches << " of " << positions
+                << " positions agree\n";
+        return mismatches;
+    }
+
+    // the same games played through the Advisor, which switches to perfect play once few tiles are left
+    void benchmarkEndgame(const int games) {
+        using SequentialBoard = Minesweeper::BasicBoard<Minesweeper::VectorStorage<>, Minesweeper::RectangularTopology,
+                                                        Minesweeper::SequentialReveal>;
+        using Reason = Minesweeper::Advisor::Reason;
+        benchClock::duration elapsed{};
+        benchClock::duration slowest{};
+        std::size_t endgames{0};
+        std::size_t positions{0};
+        int wins{0};
+        Minesweeper::Advisor advisor{16, 30, 99};
+        for (int game{0}; game < games; game++) {
+            SequentialBoard board{16, 30, 99};
+            board.setSeed(game);
+            advisor.reset();
+            Minesweeper::TileCoordinates next{8, 15};
+            while (!board.hitMine() && !board.foundAllMines()) {
+                board.checkTile(next.first, next.second);
+                const benchClock::time_point start{benchClock::now()};
+                const auto advice{advisor.advise(board)};
+                if (!advice) {
+                    break;
+                }
+                if (advice->reason == Reason::endgame) {
+                    const benchClock::duration decision{benchClock::now() - start};
+                    elapsed += decision;
+                    slowest = std::max(slowest, decision);
+                    endgames++;
+                    positions += advisor.getEndgameSolver().getPositionAmount();
+                }
+                next = advice->tile;
+            }
+            wins += board.foundAllMines();
+        }
+        report("expert, " + std::to_string(wins) + "/" + std::to_string(games) + " won", elapsed, endgames,
+               "endgame click");
+        report("expert, slowest endgame click", slowest, 1, "endgame click");
+        std::cout << positions << " positions evaluated over " << endgames << " endgame clicks\n";
+    }
+
+    // the same games again with the guesses picked by rollouts within the budget, none meaning the safest tile
+    void benchmarkGuessing(const int games, const std::chrono::microseconds budget) {
+        using SequentialBoard = Minesweeper::BasicBoard<Minesweeper::VectorStorage<>, Minesweeper::RectangularTopology,
+                                                        Minesweeper::SequentialReveal>;
+        benchClock::duration elapsed{};
+        std::size_t guesses{0};
+        int wins{0};
+        BS::thread_pool threadPool{};
+        Minesweeper::Advisor advisor{16, 30, 99, &threadPool, budget};
+        for (int game{0}; game < games; game++) {
+            SequentialBoard board{16, 30, 99};
+            board.setSeed(game);
+            advisor.reset();
+            Minesweeper::TileCoordinates next{8, 15};
+            while (!board.hitMine() && !board.foundAllMines()) {
+                board.checkTile(next.first, next.second);
+                const benchClock::time_point start{benchClock::now()};
+                const auto advice{advisor.advise(board)};
+                if (!advice) {
+                    break;
+                }
+                if (advice->reason == Minesweeper::Advisor::Reason::guess) {
+                    elapsed += benchClock::now() - start;
+                    guesses++;
+                }
+                next = advice->tile;
+            }
+            wins += board.foundAllMines();
+        }
+        const std::string guesser{
+            budget == std::chrono::microseconds::zero()
+                ? "safest tile"
+                : "rollouts for " + std::to_string(budget.count()) + " us"
+        };
+        report("expert, " + guesser + ", " + std::to_string(wins) + "/" + std::to_string(games) + " won", elapsed,
+               guesses, "guess");
+    }
+
+    // a hint after every move of expert games, from the request to the worker's call back, the way the TUI asks
+    // for one; the mean and the slowest
+    void benchmarkHints(const int games) {
+        using SequentialBoard = Minesweeper::BasicBoard<Minesweeper::VectorStorage<>, Minesweeper::RectangularTopology,
+                                                        Minesweeper::SequentialReveal>;
+        std::mutex mutex{};
+        std::condition_variable ready{};
+        std::size_t posted{0};
+        benchClock::duration elapsed{};
+        benchClock::duration slowest{};
+        std::size_t hints{0};
+        Minesweeper::Advisor advisor{16, 30, 99};
+        for (int game{0}; game < games; game++) {
+            Minesweeper::HintWorker worker{16, 30, 99, [&] {
+                const std::scoped_lock lock{mutex};
+                posted++;
+                ready.notify_one();
+            }};
+            SequentialBoard board{16, 30, 99};
+            board.setSeed(game);
+            advisor.reset();
+            Minesweeper::TileCoordinates next{8, 15};
+            while (true) {
+                board.checkTile(next.first, next.second);
+                worker.cancel();
+                if (board.hitMine() || board.foundAllMines()) {
+                    break;
+                }
+                std::unique_lock lock{mutex};
+                const std::size_t before{posted};
+                const benchClock::time_point start{benchClock::now()};
+                worker.request(board);
+                ready.wait(lock, [&] { return posted > before; });
+                const benchClock::duration latency{benchClock::now() - start};
+                lock.unlock();
+                elapsed += latency;
+                slowest = std::max(slowest, latency);
+                hints++;
+                const auto advice{advisor.advise(board)};
+                if (!advice) {
+                    break;
+                }
+                next = advice->tile;
+            }
+        }
+        report("expert, request to hint", elapsed, hints, "hint");
+        report("expert, slowest of " + std::to_string(hints), slowest, 1, "hint");
+    }
+
+    // parity elimination of a frontier-shaped system: each number sees a few consecutive tiles of a long frontier
+    void benchmarkElimination(const std::size_t numbers, const std::size_t tiles) {
+        constexpr int repetitions{2000};
+        std::mt19937 generator{0};
+        Minesweeper::ConstraintMatrix matrix{};
+        benchClock::duration elapsed{};
+        std::size_t rank{0};
+        for (int repetition{0}; repetition < repetitions; repetition++) {
+            matrix.reset(tiles);
+            for (std::size_t number{0}; number < numbers; number++) {
+                const std::size_t row{matrix.addRow(generator() % 2 == 1)};
+                const std::size_t first{std::min(number * tiles / numbers, tiles - 3)};
+                for (std::size_t tile{first}; tile < first + 3; tile++) {
+                    if (generator() % 4 != 0) {
+                        matrix.set(row, tile);
+                    }
+                }
+            }
+            const benchClock::time_point start{benchClock::now()};
+            static_cast<void>(matrix.eliminate());
+            elapsed += benchClock::now() - start;
+            rank += matrix.getRank();
+        }
+        report(std::to_string(numbers) + " numbers over " + std::to_string(tiles) + " tiles, mean rank " +
+               std::to_string(rank / repetitions), elapsed, repetitions, "elimination");
+    }
+}
+
+int main() {
+    int failures{0}; // positions or games a cross-check found wrong
+    std::cout << "Neighbourhood iteration (255 x 255)\n";
+    benchmarkNeighbourhood<true>("reference loop");
+    benchmarkNeighbourhood<false>("RectangularTopology");
+
+    std::cout << "\nFirst click and metrics (16 x 30, 99 mines)\n";
+    benchmarkTopologies<Minesweeper::VectorStorage<> >("VectorStorage");
+    benchmarkTopologies<Minesweeper::VectorStorage<Minesweeper::TiledLayout> >("VectorStorage<TiledLayout>");
+    benchmarkRevealPolicies<Minesweeper::FixedStorage<16, 30>, Minesweeper::RectangularTopology>(
+        "FixedStorage<16, 30>, Rectangular");
+
+    std::cout << "\nFirst click and metrics on a sparse 255 x 255 board (300 mines)\n";
+    benchmarkLayout<Minesweeper::RowMajorLayout>("RowMajorLayout", false);
+    benchmarkLayout<Minesweeper::TiledLayout>("TiledLayout", false);
+    benchmarkLayout<Minesweeper::RowMajorLayout>("RowMajorLayout, corridor", true);
+    benchmarkLayout<Minesweeper::TiledLayout>("TiledLayout, corridor", true);
+
+    std::cout << "\nFirst click on a 255 x 255 board by reveal engine\n";
+    for (const std::uint16_t mineCount: {300, 3000, 9000}) {
+        benchmarkRevealEngine(Minesweeper::RevealEngine::threaded, mineCount,
+                              "threaded, " + std::to_string(mineCount) + " mines");
+        benchmarkRevealEngine(Minesweeper::RevealEngine::bitParallel, mineCount,
+                              "bitParallel, " + std::to_string(mineCount) + " mines");
+    }
+    failures += crossCheckRevealEngines<Minesweeper::RectangularTopology>("RectangularTopology cross-check");
+    failures += crossCheckRevealEngines<Minesweeper::TorusTopology>("TorusTopology cross-check");
+    failures += crossCheckRevealEngines<Minesweeper::HexagonalTopology>("HexagonalTopology cross-check");
+    failures += crossCheckRevealEngines<Minesweeper::KnightTopology>("KnightTopology cross-check");
+
+    std::cout << "\nChording every satisfied number on a 255 x 255 board with every mine flagged\n";
+    for (const std::uint16_t mineCount: {3000, 9000, 15000}) {
+        benchmarkChordAll(mineCount, std::to_string(mineCount) + " mines");
+    }
+
+    std::cout << "\nRevealed tiles in random rectangles of a 255 x 255 board\n";
+    benchmarkRegionCounts<true>("scanning the tiles");
+    benchmarkRegionCounts<false>("countRegion");
+
+    std::cout << "\nRevealing and listing the frontier of a 255 x 255 board (9000 mines)\n";
+    benchmarkFrontier<true>("scanning every neighbourhood");
+    benchmarkFrontier<false>("getFrontier");
+
+    std::cout << "\nFirst click on a 256 x 256 x 256 volume, generation and flood fill\n";
+    benchmarkVolume(100'000);
+    benchmarkVolume(1'000'000);
+    benchmarkVolume(3'000'000);
+
+    std::cout << "\nGeneration and reveals on a 4096 x 4096 board (1/8 mines)\n";
+    benchmarkHugePages(Minesweeper::HugePageMode::off, "off");
+    benchmarkHugePages(Minesweeper::HugePageMode::transparent, "transparent");
+    benchmarkHugePages(Minesweeper::HugePageMode::hugetlb, "hugetlb");
+
+    std::cout << "\nRandom reveals with summary upkeep (1/4 mines)\n";
+    benchmarkSummaries(1024);
+    benchmarkSummaries(2048);
+    benchmarkSummaries(4096);
+
+    std::cout << "\nSparse boards (Elias-Fano mines, chunked reveal bitmaps)\n";
+    benchmarkSparseQueries(65536, 4'294'967);
+    benchmarkSparseQueries(65536, 42'949'672);
+    benchmarkSparseOpening(4096, 16'777);
+    benchmarkSparseOpening(4096, 167'772);
+    benchmarkSparseOpening(4096, 167'772, std::size_t{256} << 10);
+    failures += crossCheckSparseBudget(30, std::size_t{8} << 10);
+
+    std::cout << "\nSingle-point and subset deductions\n";
+    benchmarkSolver(2000);
+
+    std::cout << "\nExact mine probabilities when the deductions run out\n";
+    benchmarkProbabilities(500);
+
+    std::cout << "\nDeductions and probabilities after every move\n";
+    benchmarkIncremental(300);
+
+    std::cout << "\nExact probabilities against every layout of small boards\n";
+    failures += crossCheckProbabilities(600);
+    failures += crossCheckSampling(30, 10'000);
+
+    std::cout << "\nPerfect play over the last tiles\n";
+    benchmarkEndgame(500);
+
+    std::cout << "\nGuessing when the deductions run out\n";
+    benchmarkGuessing(500, std::chrono::microseconds::zero());
+    benchmarkGuessing(500, std::chrono::milliseconds{5});
+
+    std::cout << "\nHints worked out off the calling thread\n";
+    benchmarkHints(200);
+
+    std::cout << "\nParity elimination of the frontier's numbers\n";
+    benchmarkElimination(60, 100);
+    benchmarkElimination(200, 300);
+    return failures == 0 ? 0 : 1;
+}
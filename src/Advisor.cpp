@@ -0,0 +1,86 @@
+#include "Advisor.hpp"
+
+namespace Minesweeper {
+    template<typename Topology>
+    BasicAdvisor<Topology>::BasicAdvisor(const std::uint8_t rowAmount, const std::uint8_t columnAmount,
+                                         const std::uint16_t mineCount, BS::thread_pool* const threadPool,
+                                         const std::chrono::microseconds guessBudget,
+                                         const std::size_t endgameBudget):
+        m_solver{rowAmount, columnAmount},
+        m_probabilities{threadPool},
+        m_endgame{40, 512, endgameBudget},
+        m_guesser{threadPool, guessBudget},
+        m_mineCount{mineCount} {
+    }
+
+    // advice for the solver's current view; nothing if no hidden tile is left, the flags contradict the numbers or
+    // a stop was requested
+    template<typename Topology>
+    std::optional<typename BasicAdvisor<Topology>::Advice> BasicAdvisor<Topology>::advise(const bool incremental,
+                                                                                      const std::stop_token cancel) {
+        // whatever the probabilities were in the middle of is worthless, so the next call computes them afresh
+        const auto cancelled{[&] {
+            if (!cancel.stop_requested()) {
+                return false;
+            }
+            m_fresh = true;
+            return true;
+        }};
+        m_solver.solve();
+        if (const std::optional<TileCoordinates> safe{m_solver.nextSafeTile()}) {
+            return Advice{*safe, Reason::deduced, 1.0};
+        }
+        if (const auto move{m_endgame.solve(m_solver, m_mineCount, cancel)}) {
+            return Advice{move->tile, Reason::endgame, move->winProbability};
+        }
+        if (cancelled()) {
+            return std::nullopt;
+        }
+        const bool consistent{incremental && !m_fresh ? m_probabilities.update(m_solver, m_mineCount, cancel)
+                                                      : m_probabilities.compute(m_solver, m_mineCount, cancel)};
+        m_fresh = false;
+        if (cancelled() || !consistent) {
+            return std::nullopt;
+        }
+        // the parity elimination settles tiles the solver's rules miss; handed over, they count as its deductions
+        // and may lead it to more
+        if (m_probabilities.getForcedAmount() > 0) {
+            for (const std::uint16_t tile: m_probabilities.getSettledMineTiles()) {
+                m_solver.settle(tile, true);
+            }
+            for (const std::uint16_t tile: m_probabilities.getSettledSafeTiles()) {
+                m_solver.settle(tile, false);
+            }
+            m_solver.solve();
+            if (const std::optional<TileCoordinates> safe{m_solver.nextSafeTile()}) {
+                return Advice{*safe, Reason::deduced, 1.0};
+            }
+        }
+        if (cancelled()) {
+            return std::nullopt;
+        }
+        std::optional<TileCoordinates> guess{};
+        if (m_guesser.getBudget() > std::chrono::microseconds::zero()) {
+            if (const auto played{m_guesser.guess(m_solver, m_probabilities, m_mineCount)}) {
+                guess = played->tile;
+            }
+        } else {
+            guess = m_probabilities.safestTile(m_solver);
+        }
+        if (!guess) {
+            return std::nullopt;
+        }
+        return Advice{*guess, Reason::guess, 1.0 - m_probabilities.probabilityAt(guess->first, guess->second)};
+    }
+
+    template<typename Topology>
+    void BasicAdvisor<Topology>::reset() {
+        m_solver.reset();
+        m_fresh = true;
+    }
+
+    template class BasicAdvisor<RectangularTopology>;
+    template class BasicAdvisor<TorusTopology>;
+    template class BasicAdvisor<HexagonalTopology>;
+    template class BasicAdvisor<KnightTopology>;
+} // Minesweeper
@@ -0,0 +1,103 @@
+#ifndef ADVISOR_HPP
+#define ADVISOR_HPP
+
+#include <BS_thread_pool.hpp> // https://github.com/bshoshany/thread-pool
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <stop_token>
+
+#include "EndgameSolver.hpp"
+#include "Observer.hpp"
+#include "ProbabilitySolver.hpp"
+#include "RevealPolicy.hpp"
+#include "RolloutGuesser.hpp"
+#include "Solver.hpp"
+
+
+namespace Minesweeper {
+    // Picks the next click for a player that sees only what the board shows: a tile the BasicSolver deduced safe
+    // if there is one, else the endgame solver's best click once few enough tiles are left, else the tile least
+    // likely to be a mine, or with a time budget for guesses the one of the safest few that plays out best (see
+    // BasicRolloutGuesser). Anything that plays or hints moves goes through here, so it gets the endgame for free.
+    // Given the change lists of the moves since the last call, it re-solves only the frontier components they touch.
+    // The endgame budget, in positions, bounds how long it can take; hints that have to be quick lower it. A thread
+    // pool, which the advisor does not own, spreads the frontier components and the rollouts over its threads;
+    // without one everything runs on the calling thread. A stop requested on the token passed with the changes
+    // makes advise() give up, between its stages or inside the endgame and the enumeration, and return nothing;
+    // the probabilities it was working on are then computed from scratch next time.
+    template<typename Topology>
+    class BasicAdvisor final {
+    public:
+        enum class Reason {deduced, endgame, guess};
+
+        struct Advice {
+            TileCoordinates tile;
+            Reason reason;
+            double chance; // of the tile being safe, or for the endgame of winning from here
+        };
+
+    private:
+        BasicSolver<Topology> m_solver;
+        BasicProbabilitySolver<Topology> m_probabilities;
+        BasicEndgameSolver<Topology> m_endgame;
+        BasicRolloutGuesser<Topology> m_guesser;
+        std::uint16_t m_mineCount;
+        bool m_fresh{true}; // no probabilities to update from, since the last reset() or a cancelled advise()
+
+        [[nodiscard]] std::optional<Advice> advise(bool incremental, std::stop_token cancel);
+
+    public:
+        explicit BasicAdvisor(std::uint8_t rowAmount, std::uint8_t columnAmount, std::uint16_t mineCount,
+                              BS::thread_pool* threadPool = nullptr,
+                              std::chrono::microseconds guessBudget = std::chrono::microseconds::zero(),
+                              std::size_t endgameBudget = 200'000);
+        template<typename Board>
+        [[nodiscard]] std::optional<Advice> advise(const Board& board);
+        template<typename Board>
+        [[nodiscard]] std::optional<Advice> advise(const Board& board, std::span<const TileChange> changes,
+                                                   std::stop_token cancel = {});
+        [[nodiscard]] std::optional<Advice> advise();
+        [[nodiscard]] BasicSolver<Topology>& getSolver() noexcept;
+        [[nodiscard]] const BasicEndgameSolver<Topology>& getEndgameSolver() const noexcept;
+        void reset();
+    };
+
+    using Advisor = BasicAdvisor<RectangularTopology>;
+
+    template<typename Topology>
+    template<typename Board>
+    inline std::optional<typename BasicAdvisor<Topology>::Advice> BasicAdvisor<Topology>::advise(const Board& board) {
+        m_solver.observe(board);
+        return advise();
+    }
+
+    template<typename Topology>
+    template<typename Board>
+    inline std::optional<typename BasicAdvisor<Topology>::Advice>
+    BasicAdvisor<Topology>::advise(const Board& board, const std::span<const TileChange> changes,
+                                   const std::stop_token cancel) {
+        m_solver.observe(board, changes);
+        m_probabilities.invalidate(changes);
+        return advise(true, cancel);
+    }
+
+    template<typename Topology>
+    inline std::optional<typename BasicAdvisor<Topology>::Advice> BasicAdvisor<Topology>::advise() {
+        return advise(false, {});
+    }
+
+    template<typename Topology>
+    inline BasicSolver<Topology>& BasicAdvisor<Topology>::getSolver() noexcept {
+        return m_solver;
+    }
+
+    template<typename Topology>
+    inline const BasicEndgameSolver<Topology>& BasicAdvisor<Topology>::getEndgameSolver() const noexcept {
+        return m_endgame;
+    }
+} // Minesweeper
+
+#endif //ADVISOR_HPP
@@ -1,7 +1,8 @@
 #include "Board.hpp"
 
 #include <algorithm>
-#include <BS_thread_pool.hpp> // https://github.com/bshoshany/thread-pool
+#include <array>
+#include <bit>
 #include <cassert>
 #ifndef _MSC_VER
 #define PCG_RAND
@@ -9,39 +10,86 @@
 #include <pcg/pcg_random.hpp>
 #endif
 #include <random>
-#include <ranges>
+#include <utility>
 
 namespace Minesweeper {
-    Board::Board(const std::uint8_t rowAmount,
-                 const std::uint8_t columnAmount,
-                 const std::uint16_t mineCount): m_tileLocks(rowAmount * columnAmount),
-                                                 m_minedTiles(mineCount),
-                                                 m_uncheckedTiles(rowAmount * columnAmount),
-                                                 m_mineCount{mineCount},
-                                                 m_rowAmount{rowAmount},
-                                                 m_columnAmount{columnAmount} {
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    BasicBoard<Storage, Topology, RevealPolicy, Observer>::BasicBoard(const std::uint8_t rowAmount,
+                                                                      const std::uint8_t columnAmount,
+                                                                      const std::uint16_t mineCount,
+                                                                      const CountMode countMode,
+                                                                      const RevealEngine revealEngine,
+                                                                      Observer observer):
+        m_board(rowAmount, columnAmount),
+        m_reveal(Layout::storageSize(rowAmount, columnAmount)),
+        m_mines(rowAmount * columnAmount),
+        m_checked(rowAmount * columnAmount),
+        m_flagged(rowAmount * columnAmount),
+        m_checkedCounts(rowAmount, columnAmount),
+        m_flaggedCounts(rowAmount, columnAmount),
+        m_frontier(rowAmount * columnAmount),
+        m_borderNumbers(rowAmount * columnAmount),
+        m_closedAround(rowAmount * columnAmount, 0),
+        m_tileMarks(rowAmount * columnAmount, 0),
+        m_mineCount{mineCount},
+        m_rowAmount{rowAmount},
+        m_columnAmount{columnAmount},
+        m_countMode{countMode},
+        m_revealEngine{revealEngine},
+        m_observer{std::move(observer)} {
         assert(mineCount < m_rowAmount * m_columnAmount);
-        m_board.reserve(rowAmount * columnAmount);
-        for (std::uint_fast8_t row{0}; row < rowAmount; row++) {
-            for (std::uint_fast8_t col{0}; col < columnAmount; col++) {
-                m_board.emplace_back(row, col);
-            }
-        }
-        for (Tile& tile: m_board) {
-            m_uncheckedTiles.insert(&tile);
-        }
+        // narrower than three, a torus would reach the same neighbour over both edges and count its mine twice
+        assert(!Topology::wraps || (rowAmount >= 3 && columnAmount >= 3));
+        m_untracked.reserve(rowAmount * columnAmount);
+        m_uncounted.reserve(rowAmount * columnAmount);
     }
 
-    Tile& Board::atCoordinate(const std::uint8_t row, const std::uint8_t column) {
-        #ifdef NDEBUG
-        return m_board[gridToLinear(row, column)];
-        #else
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    Tile& BasicBoard<Storage, Topology, RevealPolicy, Observer>::atCoordinate(const std::uint8_t row,
+                                                                     const std::uint8_t column) {
         assert(row < m_rowAmount && column < m_columnAmount);
-        return m_board.at(row * m_columnAmount + column);
-        #endif
+        return m_board[gridToStorage(row, column)];
+    }
+
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    const Tile& BasicBoard<Storage, Topology, RevealPolicy, Observer>::atCoordinate(const std::uint8_t row,
+                                                                           const std::uint8_t column) const {
+        assert(row < m_rowAmount && column < m_columnAmount);
+        return m_board[gridToStorage(row, column)];
     }
 
-    void Board::checkTile(const std::uint8_t row, const std::uint8_t column) {
+    // Starts a new game on the same board without allocating: the tiles, bitmaps, counts and frontier are cleared
+    // in place, so a bot can play game after game on one board. The mines are placed again on the first check, from
+    // the seed if one is set; the seed and the observer are left as they are.
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    void BasicBoard<Storage, Topology, RevealPolicy, Observer>::reset() {
+        for (std::size_t position{0}; position < m_board.size(); position++) {
+            m_board[position].reset();
+        }
+        m_mines.clear();
+        m_checked.clear();
+        m_flagged.clear();
+        m_checkedCounts.clear();
+        m_flaggedCounts.clear();
+        m_frontier.clear();
+        m_borderNumbers.clear();
+        std::ranges::fill(m_closedAround, 0);
+        std::ranges::fill(m_tileMarks, 0);
+        m_untracked.clear();
+        m_uncounted.clear();
+        m_flagCount = 0;
+        m_zeroRows.clear();
+        m_firstCheck = true;
+        m_hitMine = false;
+        if constexpr (Observer::enabled) {
+            m_pending.changes.clear();
+            m_pending.reportedEnd = false;
+        }
+    }
+
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    void BasicBoard<Storage, Topology, RevealPolicy, Observer>::checkTile(const std::uint8_t row,
+                                                                          const std::uint8_t column) {
         Tile& tile{atCoordinate(row, column)};
         if (tile.isFlagged()) {
             return;
@@ -54,81 +102,217 @@ namespace Minesweeper {
             return;
         }
         tile.becomeChecked();
-        m_uncheckedTiles.erase(&tile);
+        markChecked(row, column);
+        recordChange(row, column, ChangeKind::revealed);
         if (tile.isMine()) {
             m_hitMine = true;
+            recordLoss(row, column);
+            publish(MoveKind::reveal, row, column);
             return;
         }
-        if (tile.getSurroundingMines() == 0) {
-            #ifdef NDEBUG
-            const std::lock_guard tileLock{m_tileLocks[gridToLinear(row, column)]};
-            #else
-            const std::lock_guard tileLock{m_tileLocks.at(gridToLinear(row, column))};
-            #endif
-            std::vector<Tile*> surroundingTiles;
-            getSurroundingTiles(surroundingTiles, row, column);
-            for (const Tile* sTile: surroundingTiles) {
-                m_threadPool.detach_task([this, sTile] {
-                    threadedCheckTile(sTile->getRow(), sTile->getColumn());
-                });
-            }
-            m_threadPool.wait();
+        resolveCount(tile);
+        if (tile.getSurroundingMines() == 0 && m_revealEngine == RevealEngine::bitParallel) {
+            dilationCheckTile(row, column);
+        } else if (tile.getSurroundingMines() == 0) {
+            std::vector<TileCoordinates> surroundingTiles;
+            surroundingTiles.reserve(Topology::maxNeighbours);
+            Topology::forEachNeighbour(m_rowAmount, m_columnAmount, row, column,
+                                       [&](const std::uint8_t r, const std::uint8_t c) {
+                                           surroundingTiles.emplace_back(r, c);
+                                       });
+            m_reveal.open(*this, surroundingTiles);
         }
+        publish(MoveKind::reveal, row, column);
     }
 
-    void Board::threadedCheckTile(const std::uint8_t row, const std::uint8_t column) {
-        #ifdef NDEBUG
-        const std::unique_lock tileLock{m_tileLocks[gridToLinear(row, column)], std::try_to_lock};
-        #else
-        const std::unique_lock tileLock{m_tileLocks.at(gridToLinear(row, column)), std::try_to_lock};
-        #endif
-        if (!tileLock.owns_lock()) {
-            // if another thread is running checkTile on this tile, just return
-            return;
-        }
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    bool BasicBoard<Storage, Topology, RevealPolicy, Observer>::openTile(const std::uint8_t row,
+                                                                         const std::uint8_t column) {
         Tile& tile{atCoordinate(row, column)};
         if (tile.isChecked() || tile.isFlagged()) {
-            return;
-        }
-        tile.becomeChecked(); {
-            std::lock_guard uncheckedLock{m_uncheckedMutex};
-            m_uncheckedTiles.erase(&tile);
+            return false;
         }
+        tile.becomeChecked();
+        m_reveal.synchronised([&] {
+            markChecked(row, column);
+            recordChange(row, column, ChangeKind::revealed);
+            if (tile.isMine()) {
+                recordLoss(row, column);
+            }
+        });
         if (tile.isMine()) {
             m_hitMine = true;
-            return;
+            return false;
+        }
+        resolveCount(tile);
+        return tile.getSurroundingMines() == 0;
+    }
+
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    template<typename Function>
+    void BasicBoard<Storage, Topology, RevealPolicy, Observer>::dilateRow(const std::uint64_t* source,
+                                                                          const std::uint8_t row,
+                                                                          Function&& target) const {
+        // ORs the row shifted by every neighbour step into the target rows, a word of 64 tiles at a time
+        const std::size_t words{wordsPerRow()};
+        const std::uint64_t lastWordMask{
+            m_columnAmount % 64 == 0 ? ~std::uint64_t{0} : (std::uint64_t{1} << m_columnAmount % 64) - 1
+        };
+        Topology::forEachOffset(row, [&](const std::int_fast8_t r, const std::int_fast8_t c) {
+            std::int_fast16_t targetRow{row + r};
+            if (targetRow < 0 || targetRow >= m_rowAmount) {
+                if constexpr (!Topology::wraps) {
+                    return;
+                }
+                targetRow = (targetRow + m_rowAmount) % m_rowAmount;
+            }
+            std::uint64_t* out{target(static_cast<std::uint8_t>(targetRow))};
+            const unsigned shift{static_cast<unsigned>(c < 0 ? -c : c)};
+            for (std::size_t word{0}; word < words; word++) {
+                std::uint64_t shifted{source[word]};
+                if (c > 0) {
+                    shifted = shifted << shift | (word > 0 ? source[word - 1] >> (64 - shift) : 0);
+                } else if (c < 0) {
+                    shifted = shifted >> shift | (word + 1 < words ? source[word + 1] << (64 - shift) : 0);
+                }
+                out[word] |= word + 1 == words ? shifted & lastWordMask : shifted;
+            }
+            if constexpr (Topology::wraps) {
+                // the steps that fell off one end of the row come back at the other
+                for (unsigned bit{0}; bit < shift; bit++) {
+                    const std::size_t from{c > 0 ? m_columnAmount - shift + bit : bit};
+                    const std::size_t to{c > 0 ? bit : m_columnAmount - shift + bit};
+                    out[to / 64] |= (source[from / 64] >> from % 64 & 1) << to % 64;
+                }
+            }
+        });
+    }
+
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    void BasicBoard<Storage, Topology, RevealPolicy, Observer>::computeZeroRows() {
+        // a tile is a zero exactly when it is neither a mine nor reached by dilating the mines
+        const std::size_t words{wordsPerRow()};
+        std::vector<std::uint64_t> mineRows(m_rowAmount * words);
+        for (std::size_t index{0}; index < m_mines.size(); index++) {
+            mineRows[index / m_columnAmount * words + index % m_columnAmount / 64] |=
+                    static_cast<std::uint64_t>(m_mines.test(index)) << (index % m_columnAmount % 64);
+        }
+        std::vector<std::uint64_t> reached(mineRows.size());
+        for (std::uint8_t row{0}; row < m_rowAmount; row++) {
+            dilateRow(&mineRows[row * words], row, [&](const std::uint8_t targetRow) {
+                return &reached[targetRow * words];
+            });
+        }
+        m_zeroRows.resize(mineRows.size());
+        for (std::size_t word{0}; word < mineRows.size(); word++) {
+            m_zeroRows[word] = ~mineRows[word] & ~reached[word];
         }
-        if (tile.getSurroundingMines() == 0) {
-            std::vector<Tile*> surroundingTiles;
-            getSurroundingTiles(surroundingTiles, row, column);
-            for (const Tile* sTile: surroundingTiles) {
-                m_threadPool.detach_task([this, sTile] {
-                    threadedCheckTile(sTile->getRow(), sTile->getColumn());
+    }
+
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    void BasicBoard<Storage, Topology, RevealPolicy, Observer>::dilationCheckTile(const std::uint8_t row,
+                                                                                  const std::uint8_t column) {
+        // Grows the opening around a freshly revealed zero breadth first, but a whole frontier at a time: the
+        // frontier's zeros are dilated in every neighbour direction, masked with the tiles that are still open to
+        // reveal, and the zeros among the new tiles form the next frontier. Only the tiles it finally reveals are
+        // touched individually.
+        if (m_zeroRows.empty()) {
+            computeZeroRows();
+        }
+        const std::size_t words{wordsPerRow()};
+        const std::uint64_t lastWordMask{
+            m_columnAmount % 64 == 0 ? ~std::uint64_t{0} : (std::uint64_t{1} << m_columnAmount % 64) - 1
+        };
+        std::vector<std::uint64_t> available(m_rowAmount * words);
+        for (std::size_t r{0}; r < m_rowAmount; r++) {
+            for (std::size_t word{0}; word < words; word++) {
+                const std::size_t position{r * m_columnAmount + word * 64};
+                available[r * words + word] = ~m_checked.bitsAt(position) & ~m_flagged.bitsAt(position)
+                                              & (word + 1 == words ? lastWordMask : ~std::uint64_t{0});
+            }
+        }
+        std::vector<std::uint64_t> frontier(available.size());
+        std::vector<std::uint64_t> reached(available.size());
+        std::vector<std::uint64_t> revealed(available.size());
+        frontier[row * words + column / 64] = std::uint64_t{1} << (column % 64);
+        // rows that can hold frontier tiles; the opening grows at most two rows per step in any topology here
+        std::int_fast16_t firstRow{row};
+        std::int_fast16_t lastRow{row};
+        while (firstRow <= lastRow) {
+            for (std::int_fast16_t r{firstRow}; r <= lastRow; r++) {
+                dilateRow(&frontier[r * words], static_cast<std::uint8_t>(r), [&](const std::uint8_t targetRow) {
+                    return &reached[targetRow * words];
                 });
             }
+            std::fill(frontier.begin() + firstRow * static_cast<std::ptrdiff_t>(words),
+                      frontier.begin() + (lastRow + 1) * static_cast<std::ptrdiff_t>(words), 0);
+            const std::int_fast16_t scanFirst{Topology::wraps ? 0 : std::max<std::int_fast16_t>(firstRow - 2, 0)};
+            const std::int_fast16_t scanLast{
+                Topology::wraps ? m_rowAmount - 1 : std::min<std::int_fast16_t>(lastRow + 2, m_rowAmount - 1)
+            };
+            firstRow = m_rowAmount;
+            lastRow = -1;
+            for (std::int_fast16_t r{scanFirst}; r <= scanLast; r++) {
+                bool hasZeros{false};
+                for (std::size_t word{r * words}; word < (r + 1) * words; word++) {
+                    const std::uint64_t newTiles{reached[word] & available[word]};
+                    reached[word] = 0;
+                    available[word] &= ~newTiles;
+                    revealed[word] |= newTiles;
+                    frontier[word] = newTiles & m_zeroRows[word];
+                    hasZeros = hasZeros || frontier[word] != 0;
+                }
+                if (hasZeros) {
+                    firstRow = std::min(firstRow, r);
+                    lastRow = std::max(lastRow, r);
+                }
+            }
+        }
+        for (std::size_t word{0}; word < revealed.size(); word++) {
+            for (std::uint64_t bits{revealed[word]}; bits != 0; bits &= bits - 1) {
+                const std::size_t index{
+                    word / words * m_columnAmount + word % words * 64 + std::countr_zero(bits)
+                };
+                Tile& tile{tileAt(index)};
+                tile.becomeChecked();
+                markChecked(tile.getRow(), tile.getColumn());
+                recordChange(tile.getRow(), tile.getColumn(), ChangeKind::revealed);
+                resolveCount(tile);
+            }
         }
     }
 
-    void Board::toggleFlag(const std::uint8_t row, const std::uint8_t column) noexcept {
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    void BasicBoard<Storage, Topology, RevealPolicy, Observer>::toggleFlag(
+        const std::uint8_t row, const std::uint8_t column) noexcept(!Observer::enabled) {
         Tile& tile{atCoordinate(row, column)};
         if (tile.isChecked()) {
             return;
         }
         if (!tile.isFlagged()) {
             m_flagCount++;
+            m_flagged.set(gridToLinear(row, column));
+            m_flaggedCounts.increment(row, column);
         } else {
             m_flagCount--;
+            m_flagged.reset(gridToLinear(row, column));
+            m_flaggedCounts.decrement(row, column);
         }
         tile.toggleFlag();
+        trackFlag(row, column, tile.isFlagged());
+        recordChange(row, column, tile.isFlagged() ? ChangeKind::flagged : ChangeKind::unflagged);
+        publish(MoveKind::flag, row, column);
     }
 
-    void Board::clearSafeTiles(const std::uint8_t row, const std::uint8_t column) {
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    void BasicBoard<Storage, Topology, RevealPolicy, Observer>::clearSafeTiles(const std::uint8_t row,
+                                                                               const std::uint8_t column) {
         const Tile& safeTile{atCoordinate(row, column)};
         if (!safeTile.isChecked() || safeTile.getSurroundingMines() == 0) {
             return;
         }
         std::vector<Tile*> uncheckedTiles;
-        uncheckedTiles.reserve(8);
+        uncheckedTiles.reserve(Topology::maxNeighbours);
         getSurroundingTiles(uncheckedTiles, row, column);
         std::erase_if(uncheckedTiles, [](const Tile* tile) { return tile->isChecked(); });
         const auto trueUncheckedTiles = std::ranges::subrange(uncheckedTiles.begin(),
@@ -137,80 +321,417 @@ namespace Minesweeper {
                                                                       return tile->isFlagged();
                                                                   }).begin());
         if (uncheckedTiles.size() - trueUncheckedTiles.size() == safeTile.getSurroundingMines()) {
+            std::vector<TileCoordinates> openedTiles;
+            openedTiles.reserve(trueUncheckedTiles.size());
             for (const Tile* tile: trueUncheckedTiles) {
-                m_threadPool.detach_task([this, tile] {
-                    threadedCheckTile(tile->getRow(), tile->getColumn());
-                });
+                openedTiles.emplace_back(tile->getRow(), tile->getColumn());
             }
-            m_threadPool.wait();
+            m_reveal.open(*this, openedTiles);
+            publish(MoveKind::chord, row, column);
         }
     }
 
-    void Board::getSurroundingTiles(std::vector<Tile*>& vec, const std::uint8_t row, const std::uint8_t column) {
-        for (std::int_fast8_t r{-1}; r <= 1; r++) {
-            if (r + row < 0 || r + row >= m_rowAmount) {
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    std::size_t BasicBoard<Storage, Topology, RevealPolicy, Observer>::chordAll() {
+        // Chords every satisfied number on the board until none is left. Every revealed number starts on a
+        // worklist; a tile whose flags account for all of its mines (or a zero) opens its remaining neighbours and
+        // those go on the worklist in turn, so each tile is looked at a bounded number of times however long the
+        // chain of chords gets. Returns how many tiles were revealed. Numbers with nothing left to open around them
+        // can never chord, so only the border numbers start out on it.
+        catchUpFrontier();
+        std::vector<std::uint16_t> worklist(m_borderNumbers.tiles().begin(), m_borderNumbers.tiles().end());
+        const std::size_t checkedBefore{m_checked.count()};
+        std::array<std::uint16_t, Topology::maxNeighbours> closedNeighbours{};
+        while (!worklist.empty() && !m_hitMine) {
+            const std::size_t index{worklist.back()};
+            worklist.pop_back();
+            const auto row{static_cast<std::uint8_t>(index / m_columnAmount)};
+            const auto column{static_cast<std::uint8_t>(index % m_columnAmount)};
+            std::uint8_t flags{0};
+            std::size_t closedAmount{0};
+            Topology::forEachNeighbour(m_rowAmount, m_columnAmount, row, column,
+                                       [&](const std::uint8_t r, const std::uint8_t c) {
+                                           const std::size_t neighbour{gridToLinear(r, c)};
+                                           if (tileAt(neighbour).isFlagged()) {
+                                               flags++;
+                                           } else if (!m_checked.test(neighbour)) {
+                                               closedNeighbours[closedAmount++] = static_cast<std::uint16_t>(
+                                                   neighbour);
+                                           }
+                                       });
+            const std::uint8_t mines{tileAt(index).getSurroundingMines()};
+            if (closedAmount == 0 || (mines != 0 && flags != mines)) {
                 continue;
             }
-            for (std::int_fast8_t c{-1}; c <= 1; c++) {
-                if (c + column < 0 || c + column >= m_columnAmount) {
+            for (std::size_t i{0}; i < closedAmount; i++) {
+                const std::size_t neighbour{closedNeighbours[i]};
+                openTile(static_cast<std::uint8_t>(neighbour / m_columnAmount),
+                         static_cast<std::uint8_t>(neighbour % m_columnAmount));
+                worklist.push_back(static_cast<std::uint16_t>(neighbour));
+            }
+        }
+        publish(MoveKind::chordAll, 0, 0);
+        return m_checked.count() - checkedBefore;
+    }
+
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    void BasicBoard<Storage, Topology, RevealPolicy, Observer>::catchUpFrontier() const noexcept {
+        // Folds the tiles revealed since the last call into the frontier. Each of them leaves it, tells its revealed
+        // neighbours they have one closed tile less and, if it is a number, brings its closed neighbours in. Only
+        // their neighbourhoods are touched, and since the whole batch is already revealed, a flood fill never adds
+        // tiles to the frontier that it has opened itself. The revealed neighbours in the batch are skipped: their
+        // closed tiles are counted once every tile of the batch is.
+        for (const std::uint16_t index: m_untracked) {
+            const Tile& tile{tileAt(index)};
+            const std::uint8_t number{tile.isMine() ? std::uint8_t{0} : tile.getSurroundingMines()};
+            m_frontier.erase(index);
+            std::uint8_t closed{0};
+            forEachNeighbour(tile.getRow(), tile.getColumn(), [&](const std::size_t neighbour) {
+                std::uint8_t& marks{m_tileMarks[neighbour]};
+                if (m_checked.test(neighbour)) {
+                    if ((marks & untrackedBit) == 0 && m_borderNumbers.contains(neighbour)
+                        && --m_closedAround[neighbour] == 0) {
+                        m_borderNumbers.erase(neighbour);
+                    }
+                    return;
+                }
+                const bool flagged{(marks & flaggedBit) != 0};
+                closed += !flagged;
+                if (number != 0 && (marks++ & countMask) == 0 && !flagged) {
+                    m_frontier.insert(neighbour);
+                }
+            });
+            if (number != 0 && closed != 0) {
+                m_closedAround[index] = closed;
+                m_borderNumbers.insert(index);
+            }
+        }
+        for (const std::uint16_t index: m_untracked) {
+            m_tileMarks[index] &= ~untrackedBit;
+        }
+        m_untracked.clear();
+    }
+
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    void BasicBoard<Storage, Topology, RevealPolicy, Observer>::countChecked() noexcept {
+        // The Fenwick tree takes the tiles a move revealed in one go at the end of it. A point update costs about
+        // log rows * log columns and a rebuild a few passes over the board, so a move that opened more than about
+        // n / log n of the n tiles rebuilds the tree from m_checked instead.
+        const std::size_t size{static_cast<std::size_t>(m_rowAmount) * m_columnAmount};
+        if (m_uncounted.size() > size / std::bit_width(size)) {
+            m_checkedCounts.rebuild([this](const std::size_t row, const std::size_t column) {
+                return m_checked.test(row * m_columnAmount + column);
+            });
+        } else {
+            for (const std::uint16_t index: m_uncounted) {
+                m_checkedCounts.increment(index / m_columnAmount, index % m_columnAmount);
+            }
+        }
+        m_uncounted.clear();
+    }
+
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    void BasicBoard<Storage, Topology, RevealPolicy, Observer>::trackFlag(const std::uint8_t row,
+                                                                          const std::uint8_t column,
+                                                                          const bool flagged) noexcept {
+        catchUpFrontier();
+        const std::size_t index{gridToLinear(row, column)};
+        std::uint8_t& marks{m_tileMarks[index]};
+        marks = flagged ? marks | flaggedBit : marks & ~flaggedBit;
+        if (flagged) {
+            m_frontier.erase(index);
+        } else if ((marks & countMask) != 0) {
+            m_frontier.insert(index);
+        }
+        forEachNeighbour(row, column, [&](const std::size_t neighbour) {
+            const Tile& tile{tileAt(neighbour)};
+            if (!m_checked.test(neighbour) || tile.isMine() || tile.getSurroundingMines() == 0) {
+                return;
+            }
+            if (flagged && --m_closedAround[neighbour] == 0) {
+                m_borderNumbers.erase(neighbour);
+            } else if (!flagged && m_closedAround[neighbour]++ == 0) {
+                m_borderNumbers.insert(neighbour);
+            }
+        });
+    }
+
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    BoardMetrics BasicBoard<Storage, Topology, RevealPolicy, Observer>::computeMetrics() const {
+        // a single pass unions every zero tile with its already visited zero neighbours and marks every tile
+        // bordering a zero, so openings fall out of the union count and isolated numbers out of the marks
+        const std::size_t tileAmount{m_mines.size()};
+        std::vector<std::uint16_t> parents(tileAmount);
+        std::vector<bool> bordersZero(tileAmount, false);
+        auto find = [&parents](std::uint16_t index) {
+            while (parents[index] != index) {
+                parents[index] = parents[parents[index]];
+                index = parents[index];
+            }
+            return index;
+        };
+        auto isZero = [this](const std::size_t index) {
+            return !tileAt(index).isMine() && surroundingMinesAt(index) == 0;
+        };
+        std::uint32_t zeroAmount{0}, unionAmount{0};
+        for (std::uint_fast8_t row{0}; row < m_rowAmount; row++) {
+            for (std::uint_fast8_t col{0}; col < m_columnAmount; col++) {
+                const std::uint16_t index{static_cast<std::uint16_t>(gridToLinear(row, col))};
+                parents[index] = index;
+                if (!isZero(index)) {
                     continue;
                 }
-                if (c == 0 && r == 0) {
+                zeroAmount++;
+                forEachNeighbour(row, col, [&](const std::size_t neighbour) {
+                    bordersZero[neighbour] = true;
+                    if (neighbour > index || !isZero(neighbour)) {
+                        return;
+                    }
+                    const std::uint16_t rootA{find(index)}, rootB{find(static_cast<std::uint16_t>(neighbour))};
+                    if (rootA != rootB) {
+                        parents[std::max(rootA, rootB)] = std::min(rootA, rootB);
+                        unionAmount++;
+                    }
+                });
+            }
+        }
+
+        BoardMetrics metrics{.openings = zeroAmount - unionAmount};
+        // greedy ZiNi: sweep the numbers once, chording wherever flags + chord save clicks over plain 3BV clicking
+        std::vector<bool> opened(tileAmount, false), revealed(tileAmount, false), flagged(tileAmount, false);
+        std::uint32_t clicks{0};
+        for (std::uint_fast8_t row{0}; row < m_rowAmount; row++) {
+            for (std::uint_fast8_t col{0}; col < m_columnAmount; col++) {
+                const std::size_t index{gridToLinear(row, col)};
+                if (tileAt(index).isMine() || isZero(index)) {
+                    continue;
+                }
+                std::array<std::uint16_t, Topology::maxNeighbours> newOpenings{};
+                std::size_t newOpeningAmount{0};
+                std::int32_t isolatedGain{0}, flagsNeeded{0};
+                bool selfRevealed{revealed[index]};
+                forEachNeighbour(row, col, [&](const std::size_t neighbour) {
+                    if (tileAt(neighbour).isMine()) {
+                        flagsNeeded += !flagged[neighbour];
+                    } else if (isZero(neighbour)) {
+                        const std::uint16_t root{find(static_cast<std::uint16_t>(neighbour))};
+                        selfRevealed = selfRevealed || opened[root];
+                        const auto end{newOpenings.begin() + newOpeningAmount};
+                        if (!opened[root] && std::find(newOpenings.begin(), end, root) == end) {
+                            newOpenings[newOpeningAmount++] = root;
+                        }
+                    } else if (!bordersZero[neighbour] && !revealed[neighbour]) {
+                        isolatedGain++;
+                    }
+                });
+                const std::int32_t openCost{selfRevealed || !bordersZero[index] ? 0 : 1};
+                if (static_cast<std::int32_t>(newOpeningAmount) + isolatedGain - flagsNeeded - 1 - openCost <= 0) {
                     continue;
                 }
-                vec.push_back(&atCoordinate(row + r, column + c));
+                clicks += (selfRevealed ? 0 : 1) + flagsNeeded + 1;
+                revealed[index] = true;
+                forEachNeighbour(row, col, [&](const std::size_t neighbour) {
+                    if (tileAt(neighbour).isMine()) {
+                        flagged[neighbour] = true;
+                    } else {
+                        revealed[neighbour] = true;
+                    }
+                });
+                for (std::size_t i{0}; i < newOpeningAmount; i++) {
+                    opened[newOpenings[i]] = true;
+                }
             }
         }
+        for (std::size_t index{0}; index < tileAmount; index++) {
+            if (tileAt(index).isMine()) {
+                continue;
+            }
+            if (isZero(index)) {
+                clicks += find(static_cast<std::uint16_t>(index)) == index && !opened[index];
+            } else if (!bordersZero[index]) {
+                metrics.isolatedNumbers++;
+                clicks += !revealed[index];
+            }
+        }
+        metrics.threeBV = metrics.openings + metrics.isolatedNumbers;
+        metrics.ziniEstimate = clicks;
+        return metrics;
     }
 
-    void Board::generateMines(const std::uint8_t row, const std::uint8_t column) {
-        std::vector<Tile*> possibleTiles;
-        std::ranges::transform(m_board, std::back_inserter(possibleTiles), [](Tile& tile) { return &tile; });
-        std::erase(possibleTiles, &atCoordinate(row, column));
-        std::vector<Tile*> surroundingTiles;
-        surroundingTiles.reserve(8);
-        getSurroundingTiles(surroundingTiles, row, column);
-        if (m_mineCount < m_rowAmount * m_columnAmount - surroundingTiles.size()) [[likely]] {
-            auto contains = [](auto& range, auto value) {
-                return std::ranges::find(range, value) != std::ranges::end(range);
-            };
-            std::erase_if(possibleTiles, [&](Tile* tile) {
-                return contains(surroundingTiles, tile);
-            });
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    void BasicBoard<Storage, Topology, RevealPolicy, Observer>::resolveCount(Tile& tile) noexcept {
+        if (m_countMode == CountMode::lazy && !tile.isCounted()) {
+            tile.setSurroundingMines(countFromBitmap(tile.getRow(), tile.getColumn()));
+        }
+    }
+
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    std::uint8_t BasicBoard<Storage, Topology, RevealPolicy, Observer>::countFromBitmap(
+        const std::uint8_t row, const std::uint8_t column) const noexcept {
+        std::uint8_t count{0};
+        forEachNeighbour(row, column, [&](const std::size_t neighbour) {
+            count += m_mines.test(neighbour);
+        });
+        return count;
+    }
+
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    std::uint8_t BasicBoard<Storage, Topology, RevealPolicy, Observer>::surroundingMinesAt(
+        const std::size_t index) const noexcept {
+        const Tile& tile{tileAt(index)};
+        if (m_countMode == CountMode::eager || tile.isCounted()) {
+            return tile.getSurroundingMines();
+        }
+        return countFromBitmap(tile.getRow(), tile.getColumn());
+    }
+
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    template<typename Function>
+    void BasicBoard<Storage, Topology, RevealPolicy, Observer>::forEachNeighbour(const std::uint8_t row,
+                                                                                 const std::uint8_t column,
+                                                                                 Function&& function) const {
+        Topology::forEachNeighbour(m_rowAmount, m_columnAmount, row, column,
+                                   [&](const std::uint8_t r, const std::uint8_t c) {
+                                       function(gridToLinear(r, c));
+                                   });
+    }
+
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    void BasicBoard<Storage, Topology, RevealPolicy, Observer>::getSurroundingTiles(std::vector<Tile*>& vec,
+                                                                                    const std::uint8_t row,
+                                                                                    const std::uint8_t column) {
+        Topology::forEachNeighbour(m_rowAmount, m_columnAmount, row, column,
+                                   [&](const std::uint8_t r, const std::uint8_t c) {
+                                       vec.push_back(&atCoordinate(r, c));
+                                   });
+    }
+
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    void BasicBoard<Storage, Topology, RevealPolicy, Observer>::generateMines(const std::uint8_t row,
+                                                                              const std::uint8_t column) {
+        // the candidate tiles are indexed once and mines are drawn as the k-th free candidate, so nothing
+        // proportional to the board is materialised or erased per mine
+        const std::size_t tileAmount{m_mines.size()};
+        RankSelectBitmap candidates{tileAmount, true};
+        candidates.reset(gridToLinear(row, column));
+        std::size_t surroundingAmount{0};
+        forEachNeighbour(row, column, [&](std::size_t) { surroundingAmount++; });
+        if (m_mineCount < tileAmount - surroundingAmount) [[likely]] {
+            forEachNeighbour(row, column, [&](const std::size_t neighbour) { candidates.reset(neighbour); });
         }
         #ifdef PCG_RAND
-        pcg32_fast rng{pcg_extras::seed_seq_from<std::random_device>()};
+        pcg32_fast rng{
+            m_seed.has_value() ? pcg32_fast{*m_seed} : pcg32_fast{pcg_extras::seed_seq_from<std::random_device>()}
+        };
+        auto randomBelow = [&](const std::size_t bound) {
+            return static_cast<std::size_t>(rng(static_cast<std::uint32_t>(bound)));
+        };
         #else
         std::random_device rand;
         std::seed_seq seedSeq{rand(), rand(), rand(), rand(), rand(), rand(), rand(), rand()};
-        std::minstd_rand rng{seedSeq};
+        std::minstd_rand rng{
+            m_seed.has_value() ? std::minstd_rand{static_cast<std::minstd_rand::result_type>(*m_seed)}
+                               : std::minstd_rand{seedSeq}
+        };
+        auto randomBelow = [&](const std::size_t bound) {
+            return std::uniform_int_distribution<std::size_t>(0, bound - 1)(rng);
+        };
         #endif
-        const std::size_t cachedSize{possibleTiles.size()};
-        for (std::uint_fast16_t i{0}; i < m_mineCount; i++) {
-            #ifdef PCG_RAND
-            const std::size_t randIndex{rng(cachedSize - i)};
-            #else
-            const std::size_t randIndex{std::uniform_int_distribution<std::size_t>(0, cachedSize - (i + 1))(rng)};
-            #endif
-            #ifdef NDEBUG
-            Tile* randTile{possibleTiles[randIndex]};
-            #else
-            Tile* randTile{possibleTiles.at(randIndex)};
-            #endif
-            m_minedTiles.insert(randTile);
-            randTile->becomeMine();
-            std::erase(possibleTiles, randTile);
-        }
-        surroundingTiles.clear();
-        surroundingTiles.reserve(8 * m_mineCount); // maximum amount of tiles that could surround all the mines
-        for (const Tile* tile: m_minedTiles) {
-            getSurroundingTiles(surroundingTiles, tile->getRow(), tile->getColumn());
-        }
-        auto nonMinedTiles = surroundingTiles | std::views::filter([](const Tile* tile) {
-            return !tile->isMine();
-        });
-        for (Tile* tile: nonMinedTiles) {
-            tile->incrementSurroundingMines();
+        // rejection stays cheap while at most half of the candidates get picked, so dense boards pick the tiles
+        // that stay free instead
+        const std::size_t candidateAmount{candidates.count()};
+        const bool invert{m_mineCount > candidateAmount / 2};
+        const std::size_t pickAmount{invert ? candidateAmount - m_mineCount : m_mineCount};
+        RankSelectBitmap picked{tileAmount};
+        while (picked.count() < pickAmount) {
+            picked.set(candidates.select(randomBelow(candidateAmount)));
+        }
+        std::vector<std::size_t> minedTiles;
+        minedTiles.reserve(m_mineCount);
+        if (invert) {
+            for (std::size_t index{0}; index < tileAmount; index++) {
+                if (candidates.test(index) && !picked.test(index)) {
+                    minedTiles.push_back(index);
+                }
+            }
+        } else {
+            for (std::size_t k{0}; k < pickAmount; k++) {
+                minedTiles.push_back(picked.select(k));
+            }
+        }
+        for (const std::size_t index: minedTiles) {
+            m_mines.set(index);
+            tileAt(index).becomeMine();
+        }
+        if (m_countMode == CountMode::lazy) {
+            return;
+        }
+        if constexpr (Layout::blockSide > 1) {
+            // walk the mines in storage order so the increments sweep the tiles block by block
+            std::ranges::sort(minedTiles, {}, [this](const std::size_t index) {
+                return Layout::toStorage(m_columnAmount, index);
+            });
+        }
+        for (const std::size_t index: minedTiles) {
+            const auto mineRow{static_cast<std::uint8_t>(index / m_columnAmount)};
+            const auto mineColumn{static_cast<std::uint8_t>(index % m_columnAmount)};
+            Topology::forEachNeighbour(m_rowAmount, m_columnAmount, mineRow, mineColumn,
+                                       [&](const std::uint8_t r, const std::uint8_t c) {
+                                           Tile& tile{m_board[gridToStorage(r, c)]};
+                                           if (!tile.isMine()) {
+                                               tile.incrementSurroundingMines();
+                                           }
+                                       });
         }
     }
+
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    std::uint32_t BasicBoard<Storage, Topology, RevealPolicy, Observer>::minesInRows(const std::uint8_t firstRow,
+                                                                                     const std::uint8_t lastRow) const {
+        assert(firstRow <= lastRow && lastRow < m_rowAmount);
+        return static_cast<std::uint32_t>(m_mines.rank(gridToLinear(lastRow, 0) + m_columnAmount)
+                                          - m_mines.rank(gridToLinear(firstRow, 0)));
+    }
+
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    std::uint32_t BasicBoard<Storage, Topology, RevealPolicy, Observer>::checkedInRows(
+        const std::uint8_t firstRow, const std::uint8_t lastRow) const {
+        assert(firstRow <= lastRow && lastRow < m_rowAmount);
+        return static_cast<std::uint32_t>(m_checked.rank(gridToLinear(lastRow, 0) + m_columnAmount)
+                                          - m_checked.rank(gridToLinear(firstRow, 0)));
+    }
+
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    std::pair<std::uint8_t, std::uint8_t> BasicBoard<Storage, Topology, RevealPolicy, Observer>::uncheckedTileAt(
+        const std::size_t k) const {
+        const std::size_t index{m_checked.select0(k)};
+        return {static_cast<std::uint8_t>(index / m_columnAmount), static_cast<std::uint8_t>(index % m_columnAmount)};
+    }
+
+    template class BasicBoard<VectorStorage<>, RectangularTopology, ParallelReveal>;
+    template class BasicBoard<VectorStorage<>, RectangularTopology, SequentialReveal>;
+    template class BasicBoard<VectorStorage<>, TorusTopology, ParallelReveal>;
+    template class BasicBoard<VectorStorage<>, TorusTopology, SequentialReveal>;
+    template class BasicBoard<VectorStorage<>, HexagonalTopology, ParallelReveal>;
+    template class BasicBoard<VectorStorage<>, HexagonalTopology, SequentialReveal>;
+    template class BasicBoard<VectorStorage<>, KnightTopology, ParallelReveal>;
+    template class BasicBoard<VectorStorage<>, KnightTopology, SequentialReveal>;
+    template class BasicBoard<VectorStorage<TiledLayout>, RectangularTopology, ParallelReveal>;
+    template class BasicBoard<VectorStorage<TiledLayout>, RectangularTopology, SequentialReveal>;
+    template class BasicBoard<VectorStorage<TiledLayout>, TorusTopology, ParallelReveal>;
+    template class BasicBoard<VectorStorage<TiledLayout>, TorusTopology, SequentialReveal>;
+    template class BasicBoard<VectorStorage<TiledLayout>, HexagonalTopology, ParallelReveal>;
+    template class BasicBoard<VectorStorage<TiledLayout>, HexagonalTopology, SequentialReveal>;
+    template class BasicBoard<VectorStorage<TiledLayout>, KnightTopology, ParallelReveal>;
+    template class BasicBoard<VectorStorage<TiledLayout>, KnightTopology, SequentialReveal>;
+    // the classic difficulties, for deployments that only ever play them
+    template class BasicBoard<FixedStorage<9, 9>, RectangularTopology, ParallelReveal>;
+    template class BasicBoard<FixedStorage<9, 9>, RectangularTopology, SequentialReveal>;
+    template class BasicBoard<FixedStorage<16, 16>, RectangularTopology, ParallelReveal>;
+    template class BasicBoard<FixedStorage<16, 16>, RectangularTopology, SequentialReveal>;
+    template class BasicBoard<FixedStorage<16, 30>, RectangularTopology, ParallelReveal>;
+    template class BasicBoard<FixedStorage<16, 30>, RectangularTopology, SequentialReveal>;
+    // recording boards, for replays and anything else that follows a game move by move
+    template class BasicBoard<VectorStorage<>, RectangularTopology, ParallelReveal, ChangeRecorder>;
+    template class BasicBoard<VectorStorage<>, RectangularTopology, SequentialReveal, ChangeRecorder>;
 } // Minesweeper
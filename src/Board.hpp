@@ -1,76 +1,323 @@
 #ifndef BOARD_HPP
 #define BOARD_HPP
-#include <BS_thread_pool.hpp> // https://github.com/bshoshany/thread-pool
 #include <cstdint>
-#include <deque>
-#include <mutex>
-#include <unordered_set>
+#include <optional>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "FenwickGrid.hpp"
+#include "Layout.hpp"
+#include "Observer.hpp"
+#include "RankSelectBitmap.hpp"
+#include "RevealPolicy.hpp"
+#include "Storage.hpp"
 #include "Tile.hpp"
+#include "TileSet.hpp"
+#include "Topology.hpp"
 
 
 namespace Minesweeper {
-    class Board final {
-        BS::thread_pool m_threadPool{BS::thread_pool()};
-        std::deque<std::mutex> m_tileLocks;
-        std::unordered_set<Tile*> m_minedTiles;
-        std::unordered_set<Tile*> m_uncheckedTiles;
-        std::vector<Tile> m_board;
-        std::mutex m_uncheckedMutex{};
+    struct BoardMetrics {
+        std::uint32_t threeBV{0};
+        std::uint32_t openings{0};
+        std::uint32_t isolatedNumbers{0};
+        std::uint32_t ziniEstimate{0}; // greedy single-sweep estimate, an upper bound of the true ZiNi
+    };
+
+    // the tiles of a rectangle by state; unrevealed tiles are the ones neither revealed nor flagged
+    struct RegionCounts {
+        std::uint32_t revealed{0};
+        std::uint32_t flagged{0};
+        std::uint32_t unrevealed{0};
+    };
+
+    // eager counts every mine's neighbours when the mines are generated, lazy counts a tile from the mine bitmap
+    // the first time it is revealed, which keeps the first click O(mines) on giant boards
+    enum class CountMode : std::uint8_t {
+        eager,
+        lazy
+    };
+
+    // threaded opens a zero region tile by tile on the thread pool, bitParallel grows it a row of up to 256 tiles
+    // at a time by shifting the revealed zeros in every neighbour direction and masking with the unrevealed tiles
+    enum class RevealEngine : std::uint8_t {
+        threaded,
+        bitParallel
+    };
+
+    // The rules of the game over three policies: Storage holds the tiles (and decides their layout and whether the
+    // size is fixed at compile time), Topology decides which tiles neighbour each other and RevealPolicy how the
+    // tiles of a zero region get opened. Everything is resolved at compile time, so no hot loop goes through a
+    // virtual call; Board is the instantiation the game has always used. Observer is told about every move as one
+    // batch of tile changes (see Observer.hpp); with the default NullObserver none of that is compiled in.
+    // The board also keeps its frontier, the unrevealed tiles next to a revealed number and the revealed numbers that
+    // still have an unrevealed neighbour. A reveal only notes the tile down and the frontier catches up with the noted
+    // tiles the next time it is asked for, so flood fills pay nothing for it until somebody looks.
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer = NullObserver>
+    class BasicBoard final {
+        friend RevealPolicy;
+        using Layout = typename Storage::Layout;
+        static constexpr std::uint8_t flaggedBit{0x80};
+        static constexpr std::uint8_t untrackedBit{0x40};
+        static constexpr std::uint8_t countMask{0x3f};
+
+        Storage m_board;
+        RevealPolicy m_reveal;
+        RankSelectBitmap m_mines;
+        RankSelectBitmap m_checked;
+        RankSelectBitmap m_flagged;
+        FenwickGrid m_checkedCounts; // rectangle counts of m_checked, brought up to date once per move
+        FenwickGrid m_flaggedCounts;
+        std::vector<std::uint16_t> m_uncounted; // the tiles the move under way revealed
+        // the frontier catches up with the tiles revealed since it was last looked at, see catchUpFrontier()
+        mutable TileSet m_frontier;
+        mutable TileSet m_borderNumbers;
+        mutable std::vector<std::uint8_t> m_closedAround; // of each border number, its neighbours still closed
+        // of each unrevealed tile, the revealed numbers around it in the low bits, with a bit for flagged and one for
+        // revealed tiles in m_untracked
+        mutable std::vector<std::uint8_t> m_tileMarks;
+        mutable std::vector<std::uint16_t> m_untracked;
         std::uint16_t m_flagCount{0};
         const std::uint16_t m_mineCount;
         const std::uint8_t m_rowAmount;
         const std::uint8_t m_columnAmount;
+        const CountMode m_countMode;
+        const RevealEngine m_revealEngine;
+        std::vector<std::uint64_t> m_zeroRows{}; // row bitboards of the zero tiles, built on the first dilation
+        std::optional<std::uint64_t> m_seed{};
         bool m_firstCheck{true};
         bool m_hitMine{false};
+        [[no_unique_address]] Observer m_observer;
+        [[no_unique_address]] std::conditional_t<Observer::enabled, detail::ChangeBuffer, detail::NoChangeBuffer>
+        m_pending{};
 
         void getSurroundingTiles(std::vector<Tile*>& vec, std::uint8_t row, std::uint8_t column);
+        bool openTile(std::uint8_t row, std::uint8_t column);
+        template<typename Function>
+        void forEachNeighbour(std::uint8_t row, std::uint8_t column, Function&& function) const;
         void generateMines(std::uint8_t row, std::uint8_t column);
-        void threadedCheckTile(std::uint8_t row, std::uint8_t column);
+        void resolveCount(Tile& tile) noexcept;
+        [[nodiscard]] std::uint8_t countFromBitmap(std::uint8_t row, std::uint8_t column) const noexcept;
+        [[nodiscard]] std::uint8_t surroundingMinesAt(std::size_t index) const noexcept;
+        void dilationCheckTile(std::uint8_t row, std::uint8_t column);
+        void computeZeroRows();
+        template<typename Function>
+        void dilateRow(const std::uint64_t* source, std::uint8_t row, Function&& target) const;
+        [[nodiscard]] std::size_t wordsPerRow() const noexcept;
         [[nodiscard]] std::size_t gridToLinear(std::uint8_t row, std::uint8_t column) const noexcept;
+        [[nodiscard]] std::size_t gridToStorage(std::uint8_t row, std::uint8_t column) const noexcept;
+        [[nodiscard]] Tile& tileAt(std::size_t index) noexcept;
+        [[nodiscard]] const Tile& tileAt(std::size_t index) const noexcept;
+        void markChecked(std::uint8_t row, std::uint8_t column) noexcept;
+        void countChecked() noexcept;
+        void catchUpFrontier() const noexcept;
+        void trackFlag(std::uint8_t row, std::uint8_t column, bool flagged) noexcept;
+        void recordChange(std::uint8_t row, std::uint8_t column, ChangeKind kind);
+        void recordLoss(std::uint8_t row, std::uint8_t column) noexcept;
+        void publish(MoveKind move, std::uint8_t row, std::uint8_t column);
 
     public:
-        explicit Board(std::uint8_t rowAmount, std::uint8_t columnAmount, std::uint16_t mineCount);
+        using StorageType = Storage;
+        using TopologyType = Topology;
+        using RevealPolicyType = RevealPolicy;
+
+        explicit BasicBoard(std::uint8_t rowAmount, std::uint8_t columnAmount, std::uint16_t mineCount,
+                            CountMode countMode = CountMode::eager,
+                            RevealEngine revealEngine = RevealEngine::threaded, Observer observer = Observer{});
         [[nodiscard]] std::uint8_t getRowAmount() const noexcept;
         [[nodiscard]] std::uint8_t getColumnAmount() const noexcept;
         [[nodiscard]] std::uint16_t getMineCount() const noexcept;
+        [[nodiscard]] CountMode getCountMode() const noexcept;
+        [[nodiscard]] RevealEngine getRevealEngine() const noexcept;
         [[nodiscard]] std::int32_t getRemainingMines() const noexcept;
         [[nodiscard]] bool foundAllMines() const noexcept;
         [[nodiscard]] bool hitMine() const noexcept;
         Tile& atCoordinate(std::uint8_t row, std::uint8_t column);
+        [[nodiscard]] const Tile& atCoordinate(std::uint8_t row, std::uint8_t column) const;
         void checkTile(std::uint8_t row, std::uint8_t column);
-        void toggleFlag(std::uint8_t row, std::uint8_t column) noexcept;
+        void toggleFlag(std::uint8_t row, std::uint8_t column) noexcept(!Observer::enabled);
         void clearSafeTiles(std::uint8_t row, std::uint8_t column);
+        std::size_t chordAll();
+        [[nodiscard]] BoardMetrics computeMetrics() const;
+        [[nodiscard]] std::uint32_t minesInRows(std::uint8_t firstRow, std::uint8_t lastRow) const;
+        [[nodiscard]] std::uint32_t checkedInRows(std::uint8_t firstRow, std::uint8_t lastRow) const;
+        [[nodiscard]] RegionCounts countRegion(std::uint8_t firstRow, std::uint8_t firstColumn, std::uint8_t lastRow,
+                                               std::uint8_t lastColumn) const noexcept;
+        [[nodiscard]] std::size_t getUncheckedAmount() const noexcept;
+        [[nodiscard]] std::pair<std::uint8_t, std::uint8_t> uncheckedTileAt(std::size_t k) const;
+        [[nodiscard]] const TileSet& getFrontier() const noexcept;
+        [[nodiscard]] const TileSet& getBorderNumbers() const noexcept;
+        void setSeed(std::uint64_t seed) noexcept;
+        void reset();
+        [[nodiscard]] Observer& getObserver() noexcept;
+        [[nodiscard]] const Observer& getObserver() const noexcept;
     };
 
-    inline std::uint8_t Board::getRowAmount() const noexcept {
+    using Board = BasicBoard<VectorStorage<>, RectangularTopology, ParallelReveal>;
+
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    inline std::uint8_t BasicBoard<Storage, Topology, RevealPolicy, Observer>::getRowAmount() const noexcept {
         return m_rowAmount;
     }
 
-    inline std::uint8_t Board::getColumnAmount() const noexcept {
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    inline std::uint8_t BasicBoard<Storage, Topology, RevealPolicy, Observer>::getColumnAmount() const noexcept {
         return m_columnAmount;
     }
 
-    inline std::uint16_t Board::getMineCount() const noexcept {
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    inline std::uint16_t BasicBoard<Storage, Topology, RevealPolicy, Observer>::getMineCount() const noexcept {
         return m_mineCount;
     }
 
-    inline std::int32_t Board::getRemainingMines() const noexcept {
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    inline CountMode BasicBoard<Storage, Topology, RevealPolicy, Observer>::getCountMode() const noexcept {
+        return m_countMode;
+    }
+
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    inline RevealEngine BasicBoard<Storage, Topology, RevealPolicy, Observer>::getRevealEngine() const noexcept {
+        return m_revealEngine;
+    }
+
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    inline std::int32_t BasicBoard<Storage, Topology, RevealPolicy, Observer>::getRemainingMines() const noexcept {
         return m_mineCount - m_flagCount;
     }
 
-    inline bool Board::foundAllMines() const noexcept {
-        return m_uncheckedTiles == m_minedTiles;
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    inline bool BasicBoard<Storage, Topology, RevealPolicy, Observer>::foundAllMines() const noexcept {
+        return !m_hitMine && m_checked.count() + m_mineCount == m_mines.size();
     }
 
-    inline bool Board::hitMine() const noexcept {
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    inline std::size_t BasicBoard<Storage, Topology, RevealPolicy, Observer>::getUncheckedAmount() const noexcept {
+        return m_checked.size() - m_checked.count();
+    }
+
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    inline void BasicBoard<Storage, Topology, RevealPolicy, Observer>::setSeed(const std::uint64_t seed) noexcept {
+        m_seed = seed;
+    }
+
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    inline bool BasicBoard<Storage, Topology, RevealPolicy, Observer>::hitMine() const noexcept {
         return m_hitMine;
     }
 
-    inline std::size_t Board::gridToLinear(const std::uint8_t row, const std::uint8_t column) const noexcept {
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    inline RegionCounts BasicBoard<Storage, Topology, RevealPolicy, Observer>::countRegion(
+        const std::uint8_t firstRow, const std::uint8_t firstColumn, const std::uint8_t lastRow,
+        const std::uint8_t lastColumn) const noexcept {
+        const std::uint32_t revealed{m_checkedCounts.count(firstRow, firstColumn, lastRow, lastColumn)};
+        const std::uint32_t flagged{m_flaggedCounts.count(firstRow, firstColumn, lastRow, lastColumn)};
+        const auto area{static_cast<std::uint32_t>((lastRow - firstRow + 1) * (lastColumn - firstColumn + 1))};
+        return {revealed, flagged, area - revealed - flagged};
+    }
+
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    inline std::size_t BasicBoard<Storage, Topology, RevealPolicy, Observer>::gridToLinear(
+        const std::uint8_t row, const std::uint8_t column) const noexcept {
         return row * m_columnAmount + column;
     }
+
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    inline std::size_t BasicBoard<Storage, Topology, RevealPolicy, Observer>::gridToStorage(
+        const std::uint8_t row, const std::uint8_t column) const noexcept {
+        return Layout::toStorage(m_columnAmount, row, column);
+    }
+
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    inline std::size_t BasicBoard<Storage, Topology, RevealPolicy, Observer>::wordsPerRow() const noexcept {
+        return (m_columnAmount + 63u) / 64u;
+    }
+
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    inline Tile& BasicBoard<Storage, Topology, RevealPolicy, Observer>::tileAt(const std::size_t index) noexcept {
+        return m_board[Layout::toStorage(m_columnAmount, index)];
+    }
+
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    inline const Tile& BasicBoard<Storage, Topology, RevealPolicy, Observer>::tileAt(
+        const std::size_t index) const noexcept {
+        return m_board[Layout::toStorage(m_columnAmount, index)];
+    }
+
+    // the unrevealed tiles next to a revealed number, i.e. the tiles the numbers say anything about
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    inline const TileSet& BasicBoard<Storage, Topology, RevealPolicy, Observer>::getFrontier() const noexcept {
+        catchUpFrontier();
+        return m_frontier;
+    }
+
+    // the revealed numbers with a neighbour that is neither revealed nor flagged
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    inline const TileSet& BasicBoard<Storage, Topology, RevealPolicy, Observer>::getBorderNumbers() const noexcept {
+        catchUpFrontier();
+        return m_borderNumbers;
+    }
+
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    inline Observer& BasicBoard<Storage, Topology, RevealPolicy, Observer>::getObserver() noexcept {
+        return m_observer;
+    }
+
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    inline const Observer& BasicBoard<Storage, Topology, RevealPolicy, Observer>::getObserver() const noexcept {
+        return m_observer;
+    }
+
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    inline void BasicBoard<Storage, Topology, RevealPolicy, Observer>::markChecked(const std::uint8_t row,
+                                                                                const std::uint8_t column) noexcept {
+        const std::size_t index{gridToLinear(row, column)};
+        m_checked.set(index);
+        m_tileMarks[index] |= untrackedBit;
+        // neither reallocates, a tile is revealed only once
+        m_untracked.push_back(static_cast<std::uint16_t>(index));
+        m_uncounted.push_back(static_cast<std::uint16_t>(index));
+    }
+
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    inline void BasicBoard<Storage, Topology, RevealPolicy, Observer>::recordChange(
+        const std::uint8_t row, const std::uint8_t column, const ChangeKind kind) {
+        if constexpr (Observer::enabled) {
+            m_pending.changes.push_back({row, column, kind});
+        }
+    }
+
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    inline void BasicBoard<Storage, Topology, RevealPolicy, Observer>::recordLoss(const std::uint8_t row,
+                                                                               const std::uint8_t column) noexcept {
+        if constexpr (Observer::enabled) {
+            m_pending.lossRow = row;
+            m_pending.lossColumn = column;
+        }
+    }
+
+    template<typename Storage, typename Topology, typename RevealPolicy, typename Observer>
+    inline void BasicBoard<Storage, Topology, RevealPolicy, Observer>::publish(
+        const MoveKind move, const std::uint8_t row, const std::uint8_t column) {
+        // hands the move's changes over in one batch, then reports the end of the game once
+        countChecked();
+        if constexpr (Observer::enabled) {
+            if (!m_pending.changes.empty()) {
+                m_observer.onChanges(ChangeList{move, row, column, m_pending.changes});
+                m_pending.changes.clear();
+            }
+            if (m_pending.reportedEnd) {
+                return;
+            }
+            if (m_hitMine) {
+                m_pending.reportedEnd = true;
+                m_observer.onLoss(m_pending.lossRow, m_pending.lossColumn);
+            } else if (foundAllMines()) {
+                m_pending.reportedEnd = true;
+                m_observer.onWin();
+            }
+        }
+    }
 } // Minesweeper
 
 #endif //BOARD_HPP
@@ -6,9 +6,11 @@
 #include "ftxui/dom/table.hpp"
 
 namespace Minesweeper {
-    BoardComponentBase::BoardComponentBase(const std::shared_ptr<Board>& board, ftxui::Closure exit): ComponentBase(),
+    BoardComponentBase::BoardComponentBase(const std::shared_ptr<Board>& board, ftxui::Closure exit,
+                                           ftxui::Closure redraw): ComponentBase(),
         m_exit{std::move(exit)},
         m_board{board},
+        m_hints{board->getRowAmount(), board->getColumnAmount(), board->getMineCount(), std::move(redraw)},
         hovered{false} {
         for (std::uint_fast8_t row{0}; row < board->getRowAmount(); row++) {
             for (std::uint_fast8_t col{0}; col < board->getColumnAmount(); col++) {
@@ -21,10 +23,18 @@ namespace Minesweeper {
     ftxui::Element BoardComponentBase::Render() {
         std::vector<std::vector<ftxui::Element> > renderElements;
         renderElements.reserve(m_board->getRowAmount());
+        const std::optional<HintWorker::Hint> hint{m_hints.getHint()};
         for (std::uint_fast8_t row{0}; row < m_board->getRowAmount(); row++) {
             std::vector<ftxui::Element> rowOfElements;
             rowOfElements.reserve(m_board->getColumnAmount());
             for (std::uint_fast8_t col{0}; col < m_board->getColumnAmount(); col++) {
+                if (hint && hint->tile.first == row && hint->tile.second == col) {
+                    // green for a tile known to be safe, yellow for the least risky guess
+                    const bool safe{hint->reason == Advisor::Reason::deduced};
+                    rowOfElements.push_back(ftxui::text("[]") | ftxui::color(ftxui::Color::Black)
+                                            | ftxui::bgcolor(safe ? ftxui::Color::Green : ftxui::Color::Yellow));
+                    continue;
+                }
                 rowOfElements.push_back(childAtCoords(row, col)->Render());
             }
             renderElements.push_back(std::move(rowOfElements));
@@ -40,6 +50,18 @@ namespace Minesweeper {
         if (m_board->foundAllMines() || m_board->hitMine()) {
             m_exit();
         }
+        if (event == ftxui::Event::Character('h')) {
+            m_hints.request(*m_board);
+            return true;
+        }
+        if (event == ftxui::Event::Character('c')) {
+            m_hints.cancel();
+            m_board->chordAll();
+            if (m_board->foundAllMines() || m_board->hitMine()) {
+                m_exit();
+            }
+            return true;
+        }
         if (!hovered || !event.is_mouse()) {
             return false;
         }
@@ -63,12 +85,15 @@ namespace Minesweeper {
         }
         switch (button) {
             case ftxui::Mouse::Left:
+                m_hints.cancel();
                 m_board->checkTile(row, column);
                 break;
             case ftxui::Mouse::Middle:
+                m_hints.cancel();
                 m_board->clearSafeTiles(row, column);
                 break;
             case ftxui::Mouse::Right:
+                m_hints.cancel();
                 m_board->toggleFlag(row, column);
                 break;
             default:
@@ -5,6 +5,7 @@
 #include <ftxui/component/task.hpp>
 
 #include "Board.hpp"
+#include "HintWorker.hpp"
 
 
 namespace Minesweeper {
@@ -14,11 +15,12 @@ namespace Minesweeper {
     class BoardComponentBase final : public ftxui::ComponentBase {
         ftxui::Closure m_exit;
         std::shared_ptr<Board> m_board;
+        HintWorker m_hints; // calls redraw from its own thread once a hint is ready
 
     public:
         bool hovered;
-        static BoardComponent Create(const std::shared_ptr<Board>& board, ftxui::Closure exit);
-        explicit BoardComponentBase(const std::shared_ptr<Board>& board, ftxui::Closure exit);
+        static BoardComponent Create(const std::shared_ptr<Board>& board, ftxui::Closure exit, ftxui::Closure redraw);
+        explicit BoardComponentBase(const std::shared_ptr<Board>& board, ftxui::Closure exit, ftxui::Closure redraw);
         ftxui::Element Render() override;
         bool OnEvent(ftxui::Event) override;
         ftxui::Component ActiveChild() override;
@@ -32,8 +34,8 @@ namespace Minesweeper {
     }
 
     inline BoardComponent BoardComponentBase::Create(
-        const std::shared_ptr<Board>& board, ftxui::Closure exit) {
-        return std::make_shared<BoardComponentBase>(board, std::move(exit));
+        const std::shared_ptr<Board>& board, ftxui::Closure exit, ftxui::Closure redraw) {
+        return std::make_shared<BoardComponentBase>(board, std::move(exit), std::move(redraw));
     }
 
     inline ftxui::Component& BoardComponentBase::childAtCoords(const size_t r, const size_t c) {
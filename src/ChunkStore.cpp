@@ -0,0 +1,215 @@
+#include "ChunkStore.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <limits>
+#include <system_error>
+#include <utility>
+#include <vector>
+#ifdef _MSC_VER
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace Minesweeper {
+    namespace {
+        // roughly what a resident chunk costs: the chunk, its hash node and its place in the recency list
+        constexpr std::size_t residentCost{
+            sizeof(ChunkStore::Chunk) + sizeof(std::uint64_t) * 4 + sizeof(void*) * 6
+        };
+
+        // chunks a compaction reads in one go, 32 KiB
+        constexpr std::size_t compactionBlock{64};
+
+        int seekTo(std::FILE* file, const std::uint64_t offset) {
+            #ifdef _MSC_VER
+            return _fseeki64(file, static_cast<__int64>(offset), SEEK_SET);
+            #else
+            return fseeko(file, static_cast<off_t>(offset), SEEK_SET);
+            #endif
+        }
+
+        int truncateTo(std::FILE* file, const std::uint64_t size) {
+            if (std::fflush(file) != 0) {
+                return -1;
+            }
+            #ifdef _MSC_VER
+            return _chsize_s(_fileno(file), static_cast<__int64>(size)) == 0 ? 0 : -1;
+            #else
+            return ftruncate(fileno(file), static_cast<off_t>(size));
+            #endif
+        }
+    }
+
+    ChunkStore::ChunkStore(const ChunkStoreOptions& options): m_spillFile{options.spillFile},
+                                                              m_residentLimit{
+                                                                  options.memoryBudget == 0
+                                                                      ? std::numeric_limits<std::size_t>::max()
+                                                                      : std::max<std::size_t>(
+                                                                          options.memoryBudget / residentCost, 1)
+                                                              } {
+    }
+
+    const ChunkStore::Chunk* ChunkStore::find(const std::uint64_t key) {
+        const Entry* entry{lookUp(key)};
+        return entry == nullptr ? nullptr : &entry->chunk;
+    }
+
+    ChunkStore::Chunk* ChunkStore::findForWrite(const std::uint64_t key) {
+        Entry* entry{lookUp(key)};
+        if (entry == nullptr) {
+            return nullptr;
+        }
+        if (entry->fileOffset.has_value()) {
+            // the copy in the file is about to be out of date
+            m_deadBytes += sizeof(Chunk);
+            entry->fileOffset.reset();
+            reclaimDeadSpace();
+        }
+        return &entry->chunk;
+    }
+
+    ChunkStore::Chunk& ChunkStore::obtain(const std::uint64_t key) {
+        if (Chunk* chunk{findForWrite(key)}; chunk != nullptr) {
+            return *chunk;
+        }
+        if (m_resident.size() >= m_residentLimit) {
+            evictColdest();
+        }
+        m_recency.push_front(key);
+        Entry& entry{m_resident.emplace(key, Entry{Chunk{}, m_recency.begin(), std::nullopt}).first->second};
+        return entry.chunk;
+    }
+
+    void ChunkStore::erase(const std::uint64_t key) {
+        if (const auto resident{m_resident.find(key)}; resident != m_resident.end()) {
+            if (resident->second.fileOffset.has_value()) {
+                m_deadBytes += sizeof(Chunk);
+            }
+            m_recency.erase(resident->second.recency);
+            m_resident.erase(resident);
+        } else if (const auto spilled{m_spilled.find(key)}; spilled != m_spilled.end()) {
+            m_deadBytes += sizeof(Chunk);
+            m_spilled.erase(spilled);
+        }
+        reclaimDeadSpace();
+    }
+
+    std::size_t ChunkStore::memoryUsage() const noexcept {
+        return m_resident.size() * residentCost + m_spilled.size() * (sizeof(std::uint64_t) * 2 + sizeof(void*) * 2);
+    }
+
+    ChunkStore::Entry* ChunkStore::lookUp(const std::uint64_t key) {
+        if (const auto resident{m_resident.find(key)}; resident != m_resident.end()) {
+            touch(resident->second);
+            return &resident->second;
+        }
+        if (!m_spilled.contains(key)) {
+            return nullptr;
+        }
+        // make room first: the eviction may compact the file, which moves this chunk's copy too
+        if (m_resident.size() >= m_residentLimit) {
+            evictColdest();
+        }
+        const auto spilled{m_spilled.find(key)};
+        const std::uint64_t offset{spilled->second};
+        Chunk chunk;
+        readChunks(&chunk, 1, offset);
+        m_spilled.erase(spilled);
+        m_recency.push_front(key);
+        return &m_resident.emplace(key, Entry{chunk, m_recency.begin(), offset}).first->second;
+    }
+
+    void ChunkStore::touch(Entry& entry) {
+        m_recency.splice(m_recency.begin(), m_recency, entry.recency);
+    }
+
+    void ChunkStore::evictColdest() {
+        const std::uint64_t key{m_recency.back()};
+        const auto resident{m_resident.find(key)};
+        Entry& entry{resident->second};
+        if (!entry.fileOffset.has_value()) {
+            entry.fileOffset = m_fileSize;
+            writeChunks(&entry.chunk, 1, m_fileSize);
+            m_fileSize += sizeof(Chunk);
+        }
+        m_spilled.emplace(key, *entry.fileOffset);
+        m_recency.pop_back();
+        m_resident.erase(resident);
+        reclaimDeadSpace();
+    }
+
+    // Once the dead space outgrows the live, moves every live copy down over it and cuts the file short. The copies
+    // move in file order a block at a time, and a block is read in whole before its live copies are written back
+    // packed, which only ever lands on blocks already read. Copies before the first dead chunk stay where they are.
+    // A compaction never rewrites more than it frees.
+    void ChunkStore::reclaimDeadSpace() {
+        if (m_deadBytes <= m_fileSize - m_deadBytes) {
+            return;
+        }
+        std::vector<std::pair<std::uint64_t, std::uint64_t*>> copies;
+        copies.reserve(static_cast<std::size_t>((m_fileSize - m_deadBytes) / sizeof(Chunk)));
+        for (auto& [key, offset] : m_spilled) {
+            copies.emplace_back(offset, &offset);
+        }
+        for (auto& [key, entry] : m_resident) {
+            if (entry.fileOffset.has_value()) {
+                copies.emplace_back(*entry.fileOffset, &*entry.fileOffset);
+            }
+        }
+        std::ranges::sort(copies);
+        std::uint64_t end{0};
+        std::size_t next{0};
+        while (next < copies.size() && copies[next].first == end) {
+            end += sizeof(Chunk);
+            next++;
+        }
+        std::vector<Chunk> block(compactionBlock);
+        while (next < copies.size()) {
+            const std::uint64_t first{copies[next].first};
+            const auto amount{
+                static_cast<std::size_t>(std::min<std::uint64_t>(compactionBlock, (m_fileSize - first) / sizeof(Chunk)))
+            };
+            readChunks(block.data(), amount, first);
+            std::size_t kept{0};
+            for (; next < copies.size() && copies[next].first < first + amount * sizeof(Chunk); next++) {
+                block[kept] = block[(copies[next].first - first) / sizeof(Chunk)];
+                *copies[next].second = end + kept * sizeof(Chunk);
+                kept++;
+            }
+            writeChunks(block.data(), kept, end);
+            end += kept * sizeof(Chunk);
+        }
+        m_fileSize = end;
+        m_deadBytes = 0;
+        if (m_file != nullptr && truncateTo(m_file.get(), m_fileSize) != 0) {
+            throw std::system_error(errno, std::generic_category(), "Could not shrink the chunk spill file");
+        }
+    }
+
+    // whatever a named spill file held before is thrown away, there is no index to make sense of it
+    void ChunkStore::openFile() {
+        m_file.reset(m_spillFile.empty() ? std::tmpfile() : std::fopen(m_spillFile.c_str(), "w+b"));
+        if (m_file == nullptr) {
+            throw std::system_error(errno, std::generic_category(), "Could not open the chunk spill file");
+        }
+    }
+
+    void ChunkStore::writeChunks(const Chunk* chunks, const std::size_t amount, const std::uint64_t offset) {
+        if (m_file == nullptr) {
+            openFile();
+        }
+        if (seekTo(m_file.get(), offset) != 0
+            || std::fwrite(chunks, sizeof(Chunk), amount, m_file.get()) != amount) {
+            throw std::system_error(errno, std::generic_category(), "Could not write to the chunk spill file");
+        }
+    }
+
+    void ChunkStore::readChunks(Chunk* chunks, const std::size_t amount, const std::uint64_t offset) {
+        if (seekTo(m_file.get(), offset) != 0
+            || std::fread(chunks, sizeof(Chunk), amount, m_file.get()) != amount) {
+            throw std::system_error(errno, std::generic_category(), "Could not read from the chunk spill file");
+        }
+    }
+} // Minesweeper
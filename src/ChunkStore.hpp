@@ -0,0 +1,97 @@
+#ifndef CHUNKSTORE_HPP
+#define CHUNKSTORE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+
+
+namespace Minesweeper {
+    struct ChunkStoreOptions {
+        std::size_t memoryBudget{0}; // bytes of chunks kept in memory, 0 keeps everything
+        std::filesystem::path spillFile{}; // scratch space for cold chunks, empty for an anonymous temporary file
+    };
+
+    // Holds chunks of board state by key. With a memory budget the chunks in memory form an LRU cache: when the
+    // budget is exceeded the least recently used chunk goes to the end of a spill file, and the in-memory index
+    // remembers where, so the next access reads it back in. A chunk that comes back unchanged keeps its place in the
+    // file and is simply dropped again the next time it is evicted. Chunks that are written to or erased leave dead
+    // space behind, and once there is more dead space than live the live chunks are moved down to the front and the
+    // file is cut short, so it never holds much more than twice what is spilled.
+    //
+    // The spill file is not persistent. It is truncated when the store first opens it, and without the index, which
+    // only ever lives in memory, its contents mean nothing; a store always starts out empty.
+    //
+    // Pointers and references handed out stay valid until the next call that can evict, which is any lookup.
+    class ChunkStore final {
+    public:
+        using Chunk = std::array<std::uint64_t, 64>;
+
+    private:
+        struct Entry {
+            Chunk chunk;
+            std::list<std::uint64_t>::iterator recency;
+            std::optional<std::uint64_t> fileOffset; // a copy in the spill file, dropped on the first write
+        };
+
+        std::unordered_map<std::uint64_t, Entry> m_resident;
+        std::list<std::uint64_t> m_recency; // most recently used first
+        std::unordered_map<std::uint64_t, std::uint64_t> m_spilled;
+        std::unique_ptr<std::FILE, int (*)(std::FILE*)> m_file{nullptr, &std::fclose};
+        std::filesystem::path m_spillFile;
+        std::uint64_t m_fileSize{0};
+        std::uint64_t m_deadBytes{0}; // copies in the file that nothing points to any more
+        std::size_t m_residentLimit;
+
+        Entry* lookUp(std::uint64_t key);
+        void touch(Entry& entry);
+        void evictColdest();
+        void reclaimDeadSpace();
+        void openFile();
+        void writeChunks(const Chunk* chunks, std::size_t amount, std::uint64_t offset);
+        void readChunks(Chunk* chunks, std::size_t amount, std::uint64_t offset);
+
+    public:
+        explicit ChunkStore(const ChunkStoreOptions& options = {});
+        ChunkStore(ChunkStore&&) noexcept = default;
+        ChunkStore& operator=(ChunkStore&&) noexcept = default;
+        [[nodiscard]] const Chunk* find(std::uint64_t key);
+        [[nodiscard]] Chunk* findForWrite(std::uint64_t key);
+        [[nodiscard]] Chunk& obtain(std::uint64_t key);
+        void erase(std::uint64_t key);
+        [[nodiscard]] std::size_t size() const noexcept;
+        [[nodiscard]] std::size_t getResidentAmount() const noexcept;
+        [[nodiscard]] std::size_t getSpilledAmount() const noexcept;
+        [[nodiscard]] std::uint64_t getFileSize() const noexcept;
+        [[nodiscard]] std::uint64_t getDeadBytes() const noexcept;
+        [[nodiscard]] std::size_t memoryUsage() const noexcept;
+    };
+
+    inline std::size_t ChunkStore::size() const noexcept {
+        return m_resident.size() + m_spilled.size();
+    }
+
+    inline std::size_t ChunkStore::getResidentAmount() const noexcept {
+        return m_resident.size();
+    }
+
+    inline std::size_t ChunkStore::getSpilledAmount() const noexcept {
+        return m_spilled.size();
+    }
+
+    inline std::uint64_t ChunkStore::getFileSize() const noexcept {
+        return m_fileSize;
+    }
+
+    inline std::uint64_t ChunkStore::getDeadBytes() const noexcept {
+        return m_deadBytes;
+    }
+} // Minesweeper
+
+#endif //CHUNKSTORE_HPP
@@ -0,0 +1,49 @@
+#include "ChunkedBitmap.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace Minesweeper {
+    ChunkedBitmap::ChunkedBitmap(const std::uint32_t columnAmount, const ChunkStoreOptions& options): m_chunks{options},
+        m_chunkColumns{(std::uint64_t{columnAmount} + chunkSide - 1) / chunkSide} {
+    }
+
+    void ChunkedBitmap::set(const std::uint32_t row, const std::uint32_t column) {
+        std::uint64_t& word{m_chunks.obtain(keyOf(row, column))[row % chunkSide]};
+        const std::uint64_t mask{std::uint64_t{1} << column % chunkSide};
+        if ((word & mask) == 0) {
+            word |= mask;
+            m_ones++;
+        }
+    }
+
+    void ChunkedBitmap::reset(const std::uint32_t row, const std::uint32_t column) {
+        // a chunk whose last bit goes is dropped again
+        const std::uint64_t key{keyOf(row, column)};
+        if (!test(row, column)) {
+            return;
+        }
+        Chunk& chunk{*m_chunks.findForWrite(key)};
+        chunk[row % chunkSide] &= ~(std::uint64_t{1} << column % chunkSide);
+        m_ones--;
+        if (std::ranges::all_of(chunk, [](const std::uint64_t bits) { return bits == 0; })) {
+            m_chunks.erase(key);
+        }
+    }
+
+    ChunkedBitmap::Chunk ChunkedBitmap::chunkAt(const std::uint32_t chunkRow, const std::uint32_t chunkColumn) const {
+        const Chunk* chunk{m_chunks.find(chunkKey(chunkRow, chunkColumn))};
+        return chunk == nullptr ? Chunk{} : *chunk;
+    }
+
+    // sets the given bits of one row of a chunk, row counted within the chunk
+    void ChunkedBitmap::setBits(const std::uint32_t chunkRow, const std::uint32_t chunkColumn, const std::uint32_t row,
+                                const std::uint64_t bits) {
+        if (bits == 0) {
+            return;
+        }
+        std::uint64_t& word{m_chunks.obtain(chunkKey(chunkRow, chunkColumn))[row]};
+        m_ones += static_cast<std::uint64_t>(std::popcount(bits & ~word));
+        word |= bits;
+    }
+} // Minesweeper
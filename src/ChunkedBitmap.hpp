@@ -0,0 +1,72 @@
+#ifndef CHUNKEDBITMAP_HPP
+#define CHUNKEDBITMAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ChunkStore.hpp"
+
+
+namespace Minesweeper {
+    // A bitmap over a grid that only stores the 64 x 64 chunks holding at least one set bit, one word per chunk
+    // row, so its memory follows the explored part of a board rather than the board's size. Reading a missing chunk
+    // costs a hash lookup and allocates nothing. The chunks live in a ChunkStore, so with a memory budget the cold
+    // ones are paged out to disk and read back in when touched.
+    class ChunkedBitmap final {
+    public:
+        static constexpr std::uint32_t chunkSide{64};
+        using Chunk = ChunkStore::Chunk;
+
+    private:
+        mutable ChunkStore m_chunks; // lookups page chunks in and reorder the cache, but leave the bits alone
+        std::uint64_t m_chunkColumns;
+        std::uint64_t m_ones{0};
+
+        [[nodiscard]] std::uint64_t keyOf(std::uint32_t row, std::uint32_t column) const noexcept;
+        [[nodiscard]] std::uint64_t chunkKey(std::uint32_t chunkRow, std::uint32_t chunkColumn) const noexcept;
+
+    public:
+        explicit ChunkedBitmap(std::uint32_t columnAmount, const ChunkStoreOptions& options = {});
+        [[nodiscard]] bool test(std::uint32_t row, std::uint32_t column) const;
+        void set(std::uint32_t row, std::uint32_t column);
+        void reset(std::uint32_t row, std::uint32_t column);
+        [[nodiscard]] Chunk chunkAt(std::uint32_t chunkRow, std::uint32_t chunkColumn) const;
+        void setBits(std::uint32_t chunkRow, std::uint32_t chunkColumn, std::uint32_t row, std::uint64_t bits);
+        [[nodiscard]] std::uint64_t count() const noexcept;
+        [[nodiscard]] std::size_t getChunkAmount() const noexcept;
+        [[nodiscard]] std::size_t memoryUsage() const noexcept;
+        [[nodiscard]] const ChunkStore& getStore() const noexcept;
+    };
+
+    inline std::uint64_t ChunkedBitmap::chunkKey(const std::uint32_t chunkRow,
+                                                 const std::uint32_t chunkColumn) const noexcept {
+        return chunkRow * m_chunkColumns + chunkColumn;
+    }
+
+    inline std::uint64_t ChunkedBitmap::keyOf(const std::uint32_t row, const std::uint32_t column) const noexcept {
+        return chunkKey(row / chunkSide, column / chunkSide);
+    }
+
+    inline bool ChunkedBitmap::test(const std::uint32_t row, const std::uint32_t column) const {
+        const Chunk* chunk{m_chunks.find(keyOf(row, column))};
+        return chunk != nullptr && ((*chunk)[row % chunkSide] >> column % chunkSide & 1) != 0;
+    }
+
+    inline std::uint64_t ChunkedBitmap::count() const noexcept {
+        return m_ones;
+    }
+
+    inline std::size_t ChunkedBitmap::getChunkAmount() const noexcept {
+        return m_chunks.size();
+    }
+
+    inline std::size_t ChunkedBitmap::memoryUsage() const noexcept {
+        return m_chunks.memoryUsage();
+    }
+
+    inline const ChunkStore& ChunkedBitmap::getStore() const noexcept {
+        return m_chunks;
+    }
+} // Minesweeper
+
+#endif //CHUNKEDBITMAP_HPP
@@ -0,0 +1,73 @@
+#include "ConstraintMatrix.hpp"
+
+#include <algorithm>
+
+namespace Minesweeper {
+    ConstraintMatrix::ConstraintMatrix(const std::size_t columnAmount) {
+        reset(columnAmount);
+    }
+
+    // drops every row and starts over with columnAmount variables, keeping the allocation
+    void ConstraintMatrix::reset(const std::size_t columnAmount) {
+        m_bits.clear();
+        m_columnAmount = columnAmount;
+        m_words = columnAmount / 64 + 1; // room for the right-hand side
+        m_rowAmount = 0;
+        m_rank = 0;
+    }
+
+    std::size_t ConstraintMatrix::addRow(const bool parity) {
+        m_bits.resize(m_bits.size() + m_words, 0);
+        if (parity) {
+            set(m_rowAmount, m_columnAmount);
+        }
+        return m_rowAmount++;
+    }
+
+    std::size_t ConstraintMatrix::weight(const std::size_t row) const noexcept {
+        const std::uint64_t* bits{rowBits(row)};
+        std::size_t weight{0};
+        for (std::size_t word{0}; word < m_words; word++) {
+            weight += std::popcount(bits[word]);
+        }
+        return weight - parity(row);
+    }
+
+    // Gauss-Jordan elimination: the first m_rank rows end up with one pivot each, cleared from every other row,
+    // and the rows after them are empty. Returns false if one of those reads 0 = 1, i.e. the numbers contradict.
+    bool ConstraintMatrix::eliminate() noexcept {
+        m_rank = 0;
+        for (std::size_t column{0}; column < m_columnAmount && m_rank < m_rowAmount; column++) {
+            const std::size_t word{column / 64};
+            const std::uint64_t bit{std::uint64_t{1} << column % 64};
+            std::size_t pivot{m_rank};
+            while (pivot < m_rowAmount && (rowBits(pivot)[word] & bit) == 0) {
+                pivot++;
+            }
+            if (pivot == m_rowAmount) {
+                continue;
+            }
+            if (pivot != m_rank) {
+                std::swap_ranges(rowBits(pivot), rowBits(pivot) + m_words, rowBits(m_rank));
+            }
+            const std::uint64_t* source{rowBits(m_rank)};
+            for (std::size_t row{0}; row < m_rowAmount; row++) {
+                std::uint64_t* target{rowBits(row)};
+                if (row == m_rank || (target[word] & bit) == 0) {
+                    continue;
+                }
+                // the words before the pivot's are already clear in the pivot row
+                for (std::size_t w{word}; w < m_words; w++) {
+                    target[w] ^= source[w];
+                }
+            }
+            m_rank++;
+        }
+        for (std::size_t row{m_rank}; row < m_rowAmount; row++) {
+            if (parity(row)) {
+                return false;
+            }
+        }
+        return true;
+    }
+} // Minesweeper
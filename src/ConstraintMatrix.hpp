@@ -0,0 +1,90 @@
+#ifndef CONSTRAINTMATRIX_HPP
+#define CONSTRAINTMATRIX_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace Minesweeper {
+    // A system of parity equations over GF(2), one packed bitset row per equation with the right-hand side as an
+    // extra column past the last variable. A revealed number says the mines next to it add up to its count, so
+    // taken modulo two every number is a row here; eliminate() brings the rows to reduced row echelon form by
+    // xoring whole words, after which a row with a single variable fixes that variable's parity and every other
+    // row is a parity check spanning its variables.
+    class ConstraintMatrix final {
+        std::vector<std::uint64_t> m_bits;
+        std::size_t m_columnAmount{0};
+        std::size_t m_words{1};
+        std::size_t m_rowAmount{0};
+        std::size_t m_rank{0};
+
+        [[nodiscard]] std::uint64_t* rowBits(std::size_t row) noexcept;
+        [[nodiscard]] const std::uint64_t* rowBits(std::size_t row) const noexcept;
+
+    public:
+        explicit ConstraintMatrix(std::size_t columnAmount = 0);
+        void reset(std::size_t columnAmount);
+        std::size_t addRow(bool parity);
+        void set(std::size_t row, std::size_t column) noexcept;
+        [[nodiscard]] bool eliminate() noexcept;
+        [[nodiscard]] std::size_t getRowAmount() const noexcept;
+        [[nodiscard]] std::size_t getColumnAmount() const noexcept;
+        [[nodiscard]] std::size_t getRank() const noexcept;
+        [[nodiscard]] bool test(std::size_t row, std::size_t column) const noexcept;
+        [[nodiscard]] bool parity(std::size_t row) const noexcept;
+        [[nodiscard]] std::size_t weight(std::size_t row) const noexcept;
+        template<typename Function>
+        void forEachColumn(std::size_t row, Function&& function) const;
+    };
+
+    inline std::uint64_t* ConstraintMatrix::rowBits(const std::size_t row) noexcept {
+        return m_bits.data() + row * m_words;
+    }
+
+    inline const std::uint64_t* ConstraintMatrix::rowBits(const std::size_t row) const noexcept {
+        return m_bits.data() + row * m_words;
+    }
+
+    inline void ConstraintMatrix::set(const std::size_t row, const std::size_t column) noexcept {
+        rowBits(row)[column / 64] |= std::uint64_t{1} << column % 64;
+    }
+
+    inline std::size_t ConstraintMatrix::getRowAmount() const noexcept {
+        return m_rowAmount;
+    }
+
+    inline std::size_t ConstraintMatrix::getColumnAmount() const noexcept {
+        return m_columnAmount;
+    }
+
+    inline std::size_t ConstraintMatrix::getRank() const noexcept {
+        return m_rank;
+    }
+
+    inline bool ConstraintMatrix::test(const std::size_t row, const std::size_t column) const noexcept {
+        return rowBits(row)[column / 64] >> column % 64 & 1;
+    }
+
+    inline bool ConstraintMatrix::parity(const std::size_t row) const noexcept {
+        return test(row, m_columnAmount);
+    }
+
+    // the variables of the row in increasing order, without the right-hand side
+    template<typename Function>
+    void ConstraintMatrix::forEachColumn(const std::size_t row, Function&& function) const {
+        const std::uint64_t* bits{rowBits(row)};
+        for (std::size_t word{0}; word < m_words; word++) {
+            for (std::uint64_t remaining{bits[word]}; remaining != 0; remaining &= remaining - 1) {
+                const std::size_t column{word * 64 + std::countr_zero(remaining)};
+                if (column == m_columnAmount) {
+                    return;
+                }
+                function(column);
+            }
+        }
+    }
+} // Minesweeper
+
+#endif //CONSTRAINTMATRIX_HPP
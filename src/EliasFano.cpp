@@ -0,0 +1,66 @@
+#include "EliasFano.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+namespace Minesweeper {
+    EliasFano::EliasFano(const std::span<const std::uint64_t> sortedValues, const std::uint64_t universe):
+        m_universe{universe},
+        m_size{sortedValues.size()},
+        m_lowBits{
+            sortedValues.empty() || universe <= sortedValues.size()
+                ? 0u
+                : static_cast<unsigned>(std::bit_width(universe / sortedValues.size()) - 1)
+        } {
+        assert(std::ranges::is_sorted(sortedValues));
+        assert(sortedValues.empty() || sortedValues.back() < universe);
+        const std::uint64_t bucketAmount{(universe >> m_lowBits) + 1};
+        m_high = RankSelectBitmap(m_size + bucketAmount);
+        m_low.assign((m_size * m_lowBits + 63) / 64 + 1, 0);
+        for (std::size_t i{0}; i < m_size; i++) {
+            const std::uint64_t value{sortedValues[i]};
+            m_high.set((value >> m_lowBits) + i);
+            if (m_lowBits == 0) {
+                continue;
+            }
+            const std::uint64_t low{value & ((std::uint64_t{1} << m_lowBits) - 1)};
+            const std::size_t bit{i * m_lowBits};
+            m_low[bit / 64] |= low << bit % 64;
+            if (bit % 64 + m_lowBits > 64) {
+                m_low[bit / 64 + 1] |= low >> (64 - bit % 64);
+            }
+        }
+        // builds the rank and select index now, so concurrent readers of the finished set never race on it
+        static_cast<void>(m_high.rank(m_high.size()));
+    }
+
+    std::uint64_t EliasFano::at(const std::size_t i) const {
+        assert(i < m_size);
+        return (m_high.select(i) - i) << m_lowBits | lowAt(i);
+    }
+
+    std::pair<std::size_t, std::size_t> EliasFano::seek(const std::uint64_t value) const {
+        // the index of the first value at or above value and the position of its bit in m_high; the values whose
+        // high bits are below value's all sit before the bucket of value, which starts after the zero closing the
+        // bucket before it
+        const std::uint64_t high{value >> m_lowBits};
+        std::size_t position{high == 0 ? 0 : m_high.select0(high - 1) + 1};
+        std::size_t i{position - high};
+        const std::uint64_t low{value & ((std::uint64_t{1} << m_lowBits) - 1)};
+        for (; m_high.test(position); position++, i++) {
+            if (lowAt(i) >= low) {
+                break;
+            }
+        }
+        return {i, position};
+    }
+
+    std::size_t EliasFano::lowerBound(const std::uint64_t value) const {
+        return value >= m_universe ? m_size : seek(value).first;
+    }
+
+    std::size_t EliasFano::memoryUsage() const noexcept {
+        return m_high.size() / 8 + m_low.size() * sizeof(std::uint64_t);
+    }
+} // Minesweeper
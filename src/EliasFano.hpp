@@ -0,0 +1,95 @@
+#ifndef ELIASFANO_HPP
+#define ELIASFANO_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "RankSelectBitmap.hpp"
+
+
+namespace Minesweeper {
+    // A sorted set of integers below a universe in about 2 + log2(universe / size) bits per element: the low bits
+    // of every value are stored verbatim and the high bits in unary, as a one per value in a bitmap where the
+    // n-th zero closes the bucket of values whose high bits are n. Finding the first value at or above x is a
+    // select0 to reach x's bucket and a scan through that one bucket. The set is immutable once built.
+    class EliasFano final {
+        RankSelectBitmap m_high;
+        std::vector<std::uint64_t> m_low;
+        std::uint64_t m_universe;
+        std::size_t m_size;
+        unsigned m_lowBits;
+
+        [[nodiscard]] std::uint64_t lowAt(std::size_t i) const noexcept;
+        [[nodiscard]] std::pair<std::size_t, std::size_t> seek(std::uint64_t value) const;
+
+    public:
+        explicit EliasFano(std::span<const std::uint64_t> sortedValues = {}, std::uint64_t universe = 0);
+        [[nodiscard]] std::size_t size() const noexcept;
+        [[nodiscard]] std::uint64_t getUniverse() const noexcept;
+        [[nodiscard]] std::uint64_t at(std::size_t i) const;
+        [[nodiscard]] std::size_t lowerBound(std::uint64_t value) const;
+        [[nodiscard]] bool contains(std::uint64_t value) const;
+        [[nodiscard]] std::size_t countInRange(std::uint64_t first, std::uint64_t last) const;
+        template<typename Function>
+        void forEachInRange(std::uint64_t first, std::uint64_t last, Function&& function) const;
+        [[nodiscard]] std::size_t memoryUsage() const noexcept;
+    };
+
+    inline std::size_t EliasFano::size() const noexcept {
+        return m_size;
+    }
+
+    inline std::uint64_t EliasFano::getUniverse() const noexcept {
+        return m_universe;
+    }
+
+    inline std::uint64_t EliasFano::lowAt(const std::size_t i) const noexcept {
+        if (m_lowBits == 0) {
+            return 0;
+        }
+        const std::size_t bit{i * m_lowBits};
+        std::uint64_t low{m_low[bit / 64] >> bit % 64};
+        if (bit % 64 + m_lowBits > 64) {
+            low |= m_low[bit / 64 + 1] << (64 - bit % 64);
+        }
+        return low & ((std::uint64_t{1} << m_lowBits) - 1);
+    }
+
+    inline bool EliasFano::contains(const std::uint64_t value) const {
+        const std::size_t i{lowerBound(value)};
+        return i < m_size && at(i) == value;
+    }
+
+    // how many values lie in [first, last]
+    inline std::size_t EliasFano::countInRange(const std::uint64_t first, const std::uint64_t last) const {
+        std::size_t amount{0};
+        forEachInRange(first, last, [&amount](std::uint64_t) { amount++; });
+        return amount;
+    }
+
+    // calls function with every value in [first, last], in order, walking the high bits from a single seek
+    template<typename Function>
+    void EliasFano::forEachInRange(const std::uint64_t first, const std::uint64_t last, Function&& function) const {
+        if (last < first || first >= m_universe) {
+            return;
+        }
+        const std::uint64_t lastHigh{last >> m_lowBits};
+        auto [i, position]{seek(first)};
+        for (; position < m_high.size() && position - i <= lastHigh; position++) {
+            if (!m_high.test(position)) {
+                continue;
+            }
+            const std::uint64_t value{(position - i) << m_lowBits | lowAt(i)};
+            if (value > last) {
+                return;
+            }
+            function(value);
+            i++;
+        }
+    }
+} // Minesweeper
+
+#endif //ELIASFANO_HPP
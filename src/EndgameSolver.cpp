@@ -0,0 +1,307 @@
+#include "EndgameSolver.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+
+namespace Minesweeper {
+    template<typename Topology>
+    BasicEndgameSolver<Topology>::BasicEndgameSolver(const std::size_t maxTiles, const std::size_t maxLayouts,
+                                                     const std::size_t positionBudget):
+        m_maxTiles{std::min<std::size_t>(maxTiles, 64)},
+        m_maxLayouts{maxLayouts},
+        m_positionBudget{positionBudget} {
+    }
+
+    template<typename Topology>
+    std::size_t BasicEndgameSolver<Topology>::PositionHash::operator()(
+        const std::vector<std::uint64_t>& position) const noexcept {
+        std::uint64_t hash{0x9E3779B97F4A7C15};
+        for (const std::uint64_t word: position) {
+            hash = (hash ^ word) * 0xBF58476D1CE4E5B9;
+            hash ^= hash >> 31;
+        }
+        return static_cast<std::size_t>(hash);
+    }
+
+    // Collects the hidden tiles and lists the layouts of the remaining mines over them by backtracking in index
+    // order, checking the numbers the last tile touches. Returns false if there are too many of either.
+    template<typename Topology>
+    bool BasicEndgameSolver<Topology>::listLayouts(const BasicSolver<Topology>& solver, const std::size_t mines) {
+        const std::size_t size{static_cast<std::size_t>(solver.getRowAmount()) * solver.getColumnAmount()};
+        const auto isPlacedMine{[&solver](const std::size_t index) {
+            return solver.viewAt(index) == BasicSolver<Topology>::flagged || solver.isKnownMine(index);
+        }};
+        std::vector<std::int16_t> positionOf(size, -1);
+        for (std::size_t index{0}; index < size; index++) {
+            if (solver.viewAt(index) == BasicSolver<Topology>::hidden && !solver.isKnownMine(index)) {
+                if (m_tiles.size() == m_maxTiles) {
+                    return false;
+                }
+                positionOf[index] = static_cast<std::int16_t>(m_tiles.size());
+                m_tiles.push_back(static_cast<std::uint16_t>(index));
+            }
+        }
+        m_allTiles = m_tiles.size() == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << m_tiles.size()) - 1;
+        if (mines > m_tiles.size()) {
+            return true; // no layout fits
+        }
+
+        for (const std::uint16_t tile: m_tiles) {
+            std::uint64_t mask{0};
+            std::uint8_t placed{0};
+            for (const std::uint16_t neighbour: solver.neighboursOf(tile)) {
+                if (positionOf[neighbour] >= 0) {
+                    mask |= std::uint64_t{1} << positionOf[neighbour];
+                } else if (isPlacedMine(neighbour)) {
+                    placed++;
+                }
+            }
+            m_neighbourMasks.push_back(mask);
+            m_placedMines.push_back(placed);
+        }
+
+        // the numbers next to the tiles, as masks over the positions and the mines still missing around them
+        std::vector<std::uint64_t> masks{};
+        std::vector<std::uint8_t> targets{};
+        std::vector<std::vector<std::uint16_t>> numbersAt(m_tiles.size());
+        for (std::size_t index{0}; index < size; index++) {
+            if (solver.viewAt(index) > Topology::maxNeighbours) {
+                continue;
+            }
+            std::uint64_t mask{0};
+            std::uint8_t placed{0};
+            for (const std::uint16_t neighbour: solver.neighboursOf(index)) {
+                if (positionOf[neighbour] >= 0) {
+                    mask |= std::uint64_t{1} << positionOf[neighbour];
+                } else if (isPlacedMine(neighbour)) {
+                    placed++;
+                }
+            }
+            if (placed > solver.viewAt(index) || solver.viewAt(index) - placed > std::popcount(mask)) {
+                return true; // wrong flags, no layout fits
+            }
+            if (mask == 0) {
+                continue;
+            }
+            for (std::uint64_t remaining{mask}; remaining != 0; remaining &= remaining - 1) {
+                numbersAt[std::countr_zero(remaining)].push_back(static_cast<std::uint16_t>(masks.size()));
+            }
+            masks.push_back(mask);
+            targets.push_back(static_cast<std::uint8_t>(solver.viewAt(index) - placed));
+        }
+
+        // a number is bounded by the mines placed next to it and the tiles still undecided there
+        const auto fits{[&](const std::uint64_t layout, const std::size_t position) {
+            const std::uint64_t later{position == 63 ? 0 : ~std::uint64_t{0} << (position + 1)};
+            for (const std::uint16_t number: numbersAt[position]) {
+                const int placed{std::popcount(layout & masks[number])};
+                const int undecided{std::popcount(masks[number] & later)};
+                if (placed > targets[number] || placed + undecided < targets[number]) {
+                    return false;
+                }
+            }
+            return true;
+        }};
+        std::vector<std::uint64_t> stack{0};
+        std::vector<std::uint8_t> depths{0};
+        while (!stack.empty()) {
+            const std::uint64_t layout{stack.back()};
+            const std::size_t position{depths.back()};
+            stack.pop_back();
+            depths.pop_back();
+            const std::size_t placed{static_cast<std::size_t>(std::popcount(layout))};
+            if (position == m_tiles.size()) {
+                if (placed == mines) {
+                    if (m_layouts.size() == m_maxLayouts) {
+                        return false;
+                    }
+                    m_layouts.push_back(layout);
+                }
+                continue;
+            }
+            const std::size_t left{m_tiles.size() - position - 1};
+            const std::uint64_t mine{layout | std::uint64_t{1} << position};
+            if (placed + 1 <= mines && fits(mine, position)) {
+                stack.push_back(mine);
+                depths.push_back(static_cast<std::uint8_t>(position + 1));
+            }
+            if (placed + left >= mines && fits(layout, position)) {
+                stack.push_back(layout);
+                depths.push_back(static_cast<std::uint8_t>(position + 1));
+            }
+        }
+        return true;
+    }
+
+    template<typename Topology>
+    inline std::uint8_t BasicEndgameSolver<Topology>::numberAt(const std::size_t tile,
+                                                               const std::uint64_t layout) const noexcept {
+        return static_cast<std::uint8_t>(m_placedMines[tile] + std::popcount(layout & m_neighbourMasks[tile]));
+    }
+
+    // the chance of winning after clicking the tile: the layouts where it is safe split by the number it shows
+    template<typename Topology>
+    double BasicEndgameSolver<Topology>::clickValue(const std::uint64_t revealed, const LayoutSet& layouts,
+                                                    const std::size_t layoutAmount, const std::size_t tile) {
+        std::array<LayoutSet, Topology::maxNeighbours + 1> outcomes{};
+        std::array<std::size_t, Topology::maxNeighbours + 1> amounts{};
+        for (std::size_t word{0}; word < layouts.size(); word++) {
+            for (std::uint64_t remaining{layouts[word]}; remaining != 0; remaining &= remaining - 1) {
+                const std::size_t layout{word * 64 + std::countr_zero(remaining)};
+                if (m_layouts[layout] >> tile & 1) {
+                    continue;
+                }
+                const std::uint8_t number{numberAt(tile, m_layouts[layout])};
+                if (outcomes[number].empty()) {
+                    outcomes[number].assign(layouts.size(), 0);
+                }
+                outcomes[number][word] |= remaining & -remaining;
+                amounts[number]++;
+            }
+        }
+        double value{0.0};
+        for (std::size_t number{0}; number < outcomes.size() && !m_gaveUp; number++) {
+            if (amounts[number] > 0) {
+                value += static_cast<double>(amounts[number]) *
+                         winProbability(revealed | std::uint64_t{1} << tile, outcomes[number]);
+            }
+        }
+        return value / static_cast<double>(layoutAmount);
+    }
+
+    template<typename Topology>
+    double BasicEndgameSolver<Topology>::winProbability(const std::uint64_t revealed, const LayoutSet& layouts) {
+        std::uint64_t anywhere{0};
+        std::uint64_t everywhere{~std::uint64_t{0}};
+        std::size_t layoutAmount{0};
+        for (std::size_t word{0}; word < layouts.size(); word++) {
+            for (std::uint64_t remaining{layouts[word]}; remaining != 0; remaining &= remaining - 1) {
+                const std::uint64_t layout{m_layouts[word * 64 + std::countr_zero(remaining)]};
+                anywhere |= layout;
+                everywhere &= layout;
+                layoutAmount++;
+            }
+        }
+        if (anywhere == everywhere) {
+            return 1.0; // the mines are known, what is left to click is safe
+        }
+
+        std::vector<std::uint64_t> position{layouts};
+        position.push_back(revealed);
+        if (const auto found{m_memo.find(position)}; found != m_memo.end()) {
+            return found->second;
+        }
+        if (++m_positions > m_positionBudget || m_cancel.stop_requested()) {
+            m_gaveUp = true;
+            return 0.0;
+        }
+
+        const std::uint64_t safe{m_allTiles & ~revealed & ~anywhere};
+        double value{0.0};
+        if (safe != 0) {
+            // a free click never hurts, so it comes first
+            value = clickValue(revealed, layouts, layoutAmount, std::countr_zero(safe));
+        } else {
+            std::size_t tile{};
+            value = bestClick(revealed, layouts, layoutAmount, tile);
+        }
+        if (!m_gaveUp) {
+            m_memo.emplace(std::move(position), value);
+        }
+        return value;
+    }
+
+    // Tries the clicks that can still win, most likely safe first; a click cannot do better than its chance of
+    // being safe, so the search stops at the first one that could not beat the best so far.
+    template<typename Topology>
+    double BasicEndgameSolver<Topology>::bestClick(const std::uint64_t revealed, const LayoutSet& layouts,
+                                                   const std::size_t layoutAmount, std::size_t& tile) {
+        std::vector<std::size_t> safeIn(m_tiles.size(), 0);
+        for (std::size_t word{0}; word < layouts.size(); word++) {
+            for (std::uint64_t remaining{layouts[word]}; remaining != 0; remaining &= remaining - 1) {
+                const std::uint64_t layout{m_layouts[word * 64 + std::countr_zero(remaining)]};
+                for (std::uint64_t open{m_allTiles & ~layout & ~revealed}; open != 0; open &= open - 1) {
+                    safeIn[std::countr_zero(open)]++;
+                }
+            }
+        }
+        std::vector<std::size_t> candidates{};
+        for (std::size_t position{0}; position < m_tiles.size(); position++) {
+            if (safeIn[position] > 0) {
+                candidates.push_back(position);
+            }
+        }
+        std::ranges::stable_sort(candidates, [&safeIn](const std::size_t a, const std::size_t b) {
+            return safeIn[a] > safeIn[b];
+        });
+
+        double best{-1.0};
+        for (const std::size_t candidate: candidates) {
+            if (static_cast<double>(safeIn[candidate]) / static_cast<double>(layoutAmount) <= best || m_gaveUp) {
+                break;
+            }
+            const double value{clickValue(revealed, layouts, layoutAmount, candidate)};
+            if (value > best) {
+                best = value;
+                tile = candidate;
+            }
+        }
+        return best;
+    }
+
+    // The best click and the chance of winning with it from here on, or nothing if the position is too big to
+    // play out, in which case the caller guesses by probability, no layout fits or a stop was requested.
+    template<typename Topology>
+    std::optional<typename BasicEndgameSolver<Topology>::Move> BasicEndgameSolver<Topology>::solve(
+        const BasicSolver<Topology>& solver, const std::uint16_t mineCount, const std::stop_token cancel) {
+        m_tiles.clear();
+        m_layouts.clear();
+        m_neighbourMasks.clear();
+        m_placedMines.clear();
+        m_memo.clear();
+        m_positions = 0;
+        m_gaveUp = false;
+        m_cancel = cancel;
+
+        const std::size_t size{static_cast<std::size_t>(solver.getRowAmount()) * solver.getColumnAmount()};
+        std::size_t placed{0};
+        for (std::size_t index{0}; index < size; index++) {
+            placed += solver.viewAt(index) == BasicSolver<Topology>::flagged || solver.isKnownMine(index);
+        }
+        if (placed > mineCount || !listLayouts(solver, mineCount - placed) || m_layouts.empty()) {
+            return std::nullopt;
+        }
+
+        const LayoutSet layouts{[this] {
+            LayoutSet all((m_layouts.size() + 63) / 64, ~std::uint64_t{0});
+            if (m_layouts.size() % 64 != 0) {
+                all.back() = (std::uint64_t{1} << m_layouts.size() % 64) - 1;
+            }
+            return all;
+        }()};
+        std::uint64_t anywhere{0};
+        for (const std::uint64_t layout: m_layouts) {
+            anywhere |= layout;
+        }
+        std::size_t tile{};
+        double value{};
+        if ((m_allTiles & ~anywhere) != 0) {
+            tile = static_cast<std::size_t>(std::countr_zero(m_allTiles & ~anywhere));
+            value = winProbability(0, layouts);
+        } else {
+            value = bestClick(0, layouts, m_layouts.size(), tile);
+        }
+        if (m_gaveUp || value < 0.0 || m_cancel.stop_requested()) {
+            return std::nullopt;
+        }
+        const std::uint8_t columnAmount{solver.getColumnAmount()};
+        return Move{{static_cast<std::uint8_t>(m_tiles[tile] / columnAmount),
+                     static_cast<std::uint8_t>(m_tiles[tile] % columnAmount)}, value};
+    }
+
+    template class BasicEndgameSolver<RectangularTopology>;
+    template class BasicEndgameSolver<TorusTopology>;
+    template class BasicEndgameSolver<HexagonalTopology>;
+    template class BasicEndgameSolver<KnightTopology>;
+} // Minesweeper
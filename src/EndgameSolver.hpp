@@ -0,0 +1,83 @@
+#ifndef ENDGAMESOLVER_HPP
+#define ENDGAMESOLVER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stop_token>
+#include <unordered_map>
+#include <vector>
+
+#include "RevealPolicy.hpp"
+#include "Solver.hpp"
+
+
+namespace Minesweeper {
+    // Plays the end of a game perfectly. Once few enough hidden tiles are left, every layout of the remaining mines
+    // over them that fits the numbers is listed as a bitmask, and the chance of winning from a set of layouts is
+    // worked out by trying each click: the layouts where the tile is a mine lose, the others split by the number
+    // the tile would show, and each part goes on as its own position. Positions are the revealed tiles plus the
+    // set of layouts still possible, a bitset over the layout list, and are memoised, since different orders of
+    // clicks keep reaching the same ones. Tiles that are safe in every layout are clicked for free before anything
+    // else, which also takes care of openings. solve() gives up, so the caller can guess by probability instead,
+    // when there are too many tiles or layouts, the search outgrows its budget or a stop is requested.
+    template<typename Topology>
+    class BasicEndgameSolver final {
+    public:
+        struct Move {
+            TileCoordinates tile;
+            double winProbability;
+        };
+
+    private:
+        using LayoutSet = std::vector<std::uint64_t>;
+
+        struct PositionHash {
+            [[nodiscard]] std::size_t operator()(const std::vector<std::uint64_t>& position) const noexcept;
+        };
+
+        std::vector<std::uint16_t> m_tiles; // the hidden tiles, by their bit in a layout
+        std::vector<std::uint64_t> m_layouts;
+        std::vector<std::uint64_t> m_neighbourMasks; // the neighbours of each tile among m_tiles
+        std::vector<std::uint8_t> m_placedMines; // the flagged and settled mines next to each tile
+        std::unordered_map<std::vector<std::uint64_t>, double, PositionHash> m_memo;
+        std::uint64_t m_allTiles{0};
+        std::size_t m_positions{0};
+        bool m_gaveUp{false};
+        std::stop_token m_cancel{}; // of the solve() under way
+        const std::size_t m_maxTiles;
+        const std::size_t m_maxLayouts;
+        const std::size_t m_positionBudget;
+
+        [[nodiscard]] bool listLayouts(const BasicSolver<Topology>& solver, std::size_t mines);
+        [[nodiscard]] std::uint8_t numberAt(std::size_t tile, std::uint64_t layout) const noexcept;
+        [[nodiscard]] double clickValue(std::uint64_t revealed, const LayoutSet& layouts, std::size_t layoutAmount,
+                                        std::size_t tile);
+        [[nodiscard]] double winProbability(std::uint64_t revealed, const LayoutSet& layouts);
+        [[nodiscard]] double bestClick(std::uint64_t revealed, const LayoutSet& layouts, std::size_t layoutAmount,
+                                       std::size_t& tile);
+
+    public:
+        explicit BasicEndgameSolver(std::size_t maxTiles = 40, std::size_t maxLayouts = 512,
+                                    std::size_t positionBudget = 200'000);
+        [[nodiscard]] std::optional<Move> solve(const BasicSolver<Topology>& solver, std::uint16_t mineCount,
+                                                std::stop_token cancel = {});
+        [[nodiscard]] std::size_t getLayoutAmount() const noexcept;
+        [[nodiscard]] std::size_t getPositionAmount() const noexcept;
+    };
+
+    using EndgameSolver = BasicEndgameSolver<RectangularTopology>;
+
+    template<typename Topology>
+    inline std::size_t BasicEndgameSolver<Topology>::getLayoutAmount() const noexcept {
+        return m_layouts.size();
+    }
+
+    // the positions the last solve() evaluated, memoised ones not counted again
+    template<typename Topology>
+    inline std::size_t BasicEndgameSolver<Topology>::getPositionAmount() const noexcept {
+        return m_positions;
+    }
+} // Minesweeper
+
+#endif //ENDGAMESOLVER_HPP
@@ -0,0 +1,48 @@
+#include "FenwickGrid.hpp"
+
+#include <cassert>
+
+namespace Minesweeper {
+    FenwickGrid::FenwickGrid(const std::size_t rowAmount, const std::size_t columnAmount):
+        m_tree((rowAmount + 1) * (columnAmount + 1), 0),
+        m_rowAmount{rowAmount},
+        m_columnAmount{columnAmount} {
+    }
+
+    void FenwickGrid::increment(const std::size_t row, const std::size_t column) noexcept {
+        assert(row < m_rowAmount && column < m_columnAmount);
+        for (std::size_t r{row + 1}; r <= m_rowAmount; r += r & -r) {
+            for (std::size_t c{column + 1}; c <= m_columnAmount; c += c & -c) {
+                m_tree[r * (m_columnAmount + 1) + c]++;
+            }
+        }
+    }
+
+    void FenwickGrid::decrement(const std::size_t row, const std::size_t column) noexcept {
+        assert(row < m_rowAmount && column < m_columnAmount);
+        for (std::size_t r{row + 1}; r <= m_rowAmount; r += r & -r) {
+            for (std::size_t c{column + 1}; c <= m_columnAmount; c += c & -c) {
+                m_tree[r * (m_columnAmount + 1) + c]--;
+            }
+        }
+    }
+
+    std::uint32_t FenwickGrid::prefix(const std::size_t rowEnd, const std::size_t columnEnd) const noexcept {
+        // the tiles in [0, rowEnd) x [0, columnEnd)
+        std::uint32_t sum{0};
+        for (std::size_t r{rowEnd}; r > 0; r &= r - 1) {
+            for (std::size_t c{columnEnd}; c > 0; c &= c - 1) {
+                sum += m_tree[r * (m_columnAmount + 1) + c];
+            }
+        }
+        return sum;
+    }
+
+    std::uint32_t FenwickGrid::count(const std::size_t firstRow, const std::size_t firstColumn,
+                                     const std::size_t lastRow, const std::size_t lastColumn) const noexcept {
+        assert(firstRow <= lastRow && lastRow < m_rowAmount);
+        assert(firstColumn <= lastColumn && lastColumn < m_columnAmount);
+        return prefix(lastRow + 1, lastColumn + 1) - prefix(firstRow, lastColumn + 1) - prefix(lastRow + 1, firstColumn)
+               + prefix(firstRow, firstColumn);
+    }
+} // Minesweeper
@@ -0,0 +1,68 @@
+#ifndef FENWICKGRID_HPP
+#define FENWICKGRID_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace Minesweeper {
+    // A two-dimensional Fenwick tree of per-tile counts: each cell holds the sum over a rectangle whose sides are
+    // the lowest set bits of its (one-based) row and column, so a point update and a prefix rectangle sum each
+    // touch O(log rows * log columns) cells. Any rectangle is then four prefix sums. rebuild() fills the whole tree
+    // from the counts in O(rows * columns), which beats that many point updates once they are more than a few.
+    class FenwickGrid final {
+        std::vector<std::uint32_t> m_tree;
+        std::size_t m_rowAmount;
+        std::size_t m_columnAmount;
+
+        [[nodiscard]] std::uint32_t prefix(std::size_t rowEnd, std::size_t columnEnd) const noexcept;
+
+    public:
+        explicit FenwickGrid(std::size_t rowAmount = 0, std::size_t columnAmount = 0);
+        void increment(std::size_t row, std::size_t column) noexcept;
+        void decrement(std::size_t row, std::size_t column) noexcept;
+        void clear() noexcept;
+        template<typename Function>
+        void rebuild(Function&& countAt) noexcept;
+        [[nodiscard]] std::uint32_t count(std::size_t firstRow, std::size_t firstColumn, std::size_t lastRow,
+                                          std::size_t lastColumn) const noexcept;
+        [[nodiscard]] std::uint32_t total() const noexcept;
+    };
+
+    inline void FenwickGrid::clear() noexcept {
+        std::ranges::fill(m_tree, 0);
+    }
+
+    inline std::uint32_t FenwickGrid::total() const noexcept {
+        return prefix(m_rowAmount, m_columnAmount);
+    }
+
+    // countAt(row, column) for every tile; each cell passes its sum on to its parent along the columns, then each
+    // row to its parent row, so every cell ends up with its rectangle
+    template<typename Function>
+    void FenwickGrid::rebuild(Function&& countAt) noexcept {
+        const std::size_t stride{m_columnAmount + 1};
+        for (std::size_t r{1}; r <= m_rowAmount; r++) {
+            std::uint32_t* const row{&m_tree[r * stride]};
+            for (std::size_t c{1}; c <= m_columnAmount; c++) {
+                row[c] = static_cast<std::uint32_t>(countAt(r - 1, c - 1));
+            }
+            for (std::size_t c{1}; c <= m_columnAmount; c++) {
+                if (const std::size_t parent{c + (c & -c)}; parent <= m_columnAmount) {
+                    row[parent] += row[c];
+                }
+            }
+        }
+        for (std::size_t r{1}; r <= m_rowAmount; r++) {
+            if (const std::size_t parent{r + (r & -r)}; parent <= m_rowAmount) {
+                for (std::size_t c{1}; c <= m_columnAmount; c++) {
+                    m_tree[parent * stride + c] += m_tree[r * stride + c];
+                }
+            }
+        }
+    }
+} // Minesweeper
+
+#endif //FENWICKGRID_HPP
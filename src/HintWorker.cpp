@@ -0,0 +1,94 @@
+#include "HintWorker.hpp"
+
+#include <utility>
+
+namespace Minesweeper {
+    HintWorker::HintWorker(const std::uint8_t rowAmount, const std::uint8_t columnAmount,
+                           const std::uint16_t mineCount, std::function<void()> onHint):
+        m_rowAmount{rowAmount},
+        m_columnAmount{columnAmount},
+        m_advisor{rowAmount, columnAmount, mineCount, nullptr, std::chrono::microseconds::zero(), endgameBudget},
+        m_onHint{std::move(onHint)},
+        m_taken{columnAmount, {}},
+        m_seen{columnAmount, {}},
+        m_requested{columnAmount, {}} {
+        const std::size_t size{static_cast<std::size_t>(rowAmount) * columnAmount};
+        m_taken.tiles.reserve(size);
+        m_requested.tiles.reserve(size);
+        m_seen.tiles.reserve(size);
+        for (std::uint8_t row{0}; row < rowAmount; row++) {
+            for (std::uint8_t column{0}; column < columnAmount; column++) {
+                m_seen.tiles.emplace_back(row, column);
+            }
+        }
+        m_changes.reserve(size);
+        m_worker = std::jthread{[this](const std::stop_token stop) {
+            work(stop);
+        }};
+    }
+
+    // the board changed: the hint is gone, and so is any request for the board as it was
+    void HintWorker::cancel() {
+        const std::scoped_lock lock{m_mutex};
+        m_generation++;
+        m_pending.reset();
+        m_hint.reset();
+        m_advising.request_stop();
+    }
+
+    std::optional<HintWorker::Hint> HintWorker::getHint() {
+        const std::scoped_lock lock{m_mutex};
+        return m_hint;
+    }
+
+    void HintWorker::work(const std::stop_token stop) {
+        // a worker told to stop gives up on the hint at hand as well
+        const std::stop_callback stopAdvising{stop, [this] {
+            const std::scoped_lock lock{m_mutex};
+            m_advising.request_stop();
+        }};
+        while (true) {
+            std::uint64_t generation{0};
+            std::stop_token cancel{};
+            {
+                std::unique_lock lock{m_mutex};
+                if (!m_wake.wait(lock, stop, [this] { return m_pending.has_value(); }) || stop.stop_requested()) {
+                    return;
+                }
+                generation = *m_pending;
+                m_pending.reset();
+                std::swap(m_taken, m_requested);
+                m_advising = std::stop_source{};
+                cancel = m_advising.get_token();
+            }
+            diff();
+            const auto hint{m_advisor.advise(m_taken, m_changes, cancel)};
+            std::swap(m_seen, m_taken);
+            {
+                const std::scoped_lock lock{m_mutex};
+                if (!hint || generation != m_generation) {
+                    continue;
+                }
+                m_hint = hint;
+            }
+            m_onHint();
+        }
+    }
+
+    // the change list from the last snapshot advised on to the one just taken; tiles only ever get revealed, and
+    // flags come and go
+    void HintWorker::diff() {
+        m_changes.clear();
+        for (std::size_t index{0}; index < m_taken.tiles.size(); index++) {
+            const Tile& now{m_taken.tiles[index]};
+            const Tile& before{m_seen.tiles[index]};
+            const auto row{static_cast<std::uint8_t>(index / m_columnAmount)};
+            const auto column{static_cast<std::uint8_t>(index % m_columnAmount)};
+            if (now.isChecked() && !before.isChecked()) {
+                m_changes.push_back({row, column, ChangeKind::revealed});
+            } else if (now.isFlagged() != before.isFlagged()) {
+                m_changes.push_back({row, column, now.isFlagged() ? ChangeKind::flagged : ChangeKind::unflagged});
+            }
+        }
+    }
+} // Minesweeper
@@ -0,0 +1,91 @@
+#ifndef HINTWORKER_HPP
+#define HINTWORKER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+#include "Advisor.hpp"
+#include "Observer.hpp"
+#include "Tile.hpp"
+
+
+namespace Minesweeper {
+    // Works out hints on a thread of its own, so whoever asks never waits for the solvers. request() copies what the
+    // board shows and returns; the worker diffs the copy against the last one it advised on, hands the differences
+    // to its advisor as a change list, stores the hint for getHint() and calls onHint from the worker thread. A board
+    // that changes makes the hint wrong, so cancel() drops the hint and any request not taken yet, and stops a hint
+    // still being worked out through the stop token the advisor was given, which then starts its next hint from
+    // scratch. The endgame gets a small budget, which keeps a hint to a few milliseconds on an expert board.
+    class HintWorker final {
+    public:
+        using Hint = Advisor::Advice;
+
+        static constexpr std::size_t endgameBudget{1'000}; // positions
+
+    private:
+        // the tiles as the board showed them, all the advisor looks at
+        struct Snapshot {
+            std::uint8_t columnAmount;
+            std::vector<Tile> tiles;
+
+            [[nodiscard]] const Tile& atCoordinate(std::uint8_t row, std::uint8_t column) const noexcept;
+        };
+
+        const std::uint8_t m_rowAmount;
+        const std::uint8_t m_columnAmount;
+        Advisor m_advisor;
+        std::function<void()> m_onHint;
+        // the worker's own: the copy it is advising on, the one before and their differences
+        Snapshot m_taken;
+        Snapshot m_seen;
+        std::vector<TileChange> m_changes;
+        // shared with request() and cancel(), behind m_mutex
+        std::mutex m_mutex;
+        std::condition_variable_any m_wake;
+        Snapshot m_requested;
+        std::uint64_t m_generation{0}; // of the board, one more with every cancel()
+        std::optional<std::uint64_t> m_pending{}; // the generation of a request not taken yet
+        std::optional<Hint> m_hint{};
+        std::stop_source m_advising{}; // stops the hint being worked out
+        std::jthread m_worker; // last, so it starts after the rest is built and stops before it is destroyed
+
+        void work(std::stop_token stop);
+        void diff();
+
+    public:
+        explicit HintWorker(std::uint8_t rowAmount, std::uint8_t columnAmount, std::uint16_t mineCount,
+                            std::function<void()> onHint);
+        template<typename Board>
+        void request(const Board& board);
+        void cancel();
+        [[nodiscard]] std::optional<Hint> getHint();
+    };
+
+    inline const Tile& HintWorker::Snapshot::atCoordinate(const std::uint8_t row,
+                                                          const std::uint8_t column) const noexcept {
+        return tiles[static_cast<std::size_t>(row) * columnAmount + column];
+    }
+
+    // a hint for the board as it is now, replacing a request the worker has not got to
+    template<typename Board>
+    void HintWorker::request(const Board& board) {
+        const std::scoped_lock lock{m_mutex};
+        m_requested.tiles.clear();
+        for (std::uint8_t row{0}; row < m_rowAmount; row++) {
+            for (std::uint8_t column{0}; column < m_columnAmount; column++) {
+                m_requested.tiles.push_back(board.atCoordinate(row, column));
+            }
+        }
+        m_pending = m_generation;
+        m_wake.notify_one();
+    }
+} // Minesweeper
+
+#endif //HINTWORKER_HPP
@@ -0,0 +1,62 @@
+#include "HugePageAllocator.hpp"
+
+#include <atomic>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace Minesweeper {
+    namespace {
+        std::atomic<HugePageMode> hugePageMode{HugePageMode::off};
+
+        #ifdef __linux__
+        // mappings are always a whole number of huge pages long, whichever pages end up backing them, so
+        // deallocation can recompute the length from the requested size alone
+        constexpr std::size_t mappingLength(const std::size_t bytes) noexcept {
+            return (bytes + detail::hugePageThreshold - 1) / detail::hugePageThreshold * detail::hugePageThreshold;
+        }
+        #endif
+    }
+
+    void setHugePageMode(const HugePageMode mode) noexcept {
+        hugePageMode.store(mode, std::memory_order_relaxed);
+    }
+
+    HugePageMode getHugePageMode() noexcept {
+        return hugePageMode.load(std::memory_order_relaxed);
+    }
+
+    namespace detail {
+        void* allocateMapping(const std::size_t bytes, const HugePageMode mode) {
+            #ifdef __linux__
+            const std::size_t length{mappingLength(bytes)};
+            if (mode == HugePageMode::hugetlb) {
+                void* pointer{mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+                                   -1, 0)};
+                if (pointer != MAP_FAILED) {
+                    return pointer;
+                }
+                // the reserved pool is empty or not configured, so ask for transparent huge pages instead
+            }
+            void* pointer{mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)};
+            if (pointer == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+            // advice is only a hint, so a kernel without transparent huge pages failing it is fine
+            madvise(pointer, length, MADV_HUGEPAGE);
+            return pointer;
+            #else
+            static_cast<void>(mode);
+            return ::operator new(bytes);
+            #endif
+        }
+
+        void deallocateMapping(void* pointer, const std::size_t bytes) noexcept {
+            #ifdef __linux__
+            munmap(pointer, mappingLength(bytes));
+            #else
+            ::operator delete(pointer);
+            #endif
+        }
+    }
+} // Minesweeper
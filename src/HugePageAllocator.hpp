@@ -0,0 +1,87 @@
+#ifndef HUGEPAGEALLOCATOR_HPP
+#define HUGEPAGEALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+
+namespace Minesweeper {
+    enum class HugePageMode : std::uint8_t {
+        off, // everything goes through operator new, as it would without this allocator
+        transparent, // large allocations are advised to the kernel as huge page candidates
+        hugetlb // large allocations are taken from the reserved huge page pool, falling back to transparent
+    };
+
+    // the mode only affects allocators created after it is set; each allocator keeps the mode it was created under so
+    // memory always goes back the way it came, even when the mode changes in between
+    void setHugePageMode(HugePageMode mode) noexcept;
+    [[nodiscard]] HugePageMode getHugePageMode() noexcept;
+
+    namespace detail {
+        // unless the mode is off, allocations of at least this many bytes get their own mapping and anything smaller
+        // goes to operator new
+        constexpr std::size_t hugePageThreshold{std::size_t{2} << 20};
+
+        [[nodiscard]] void* allocateMapping(std::size_t bytes, HugePageMode mode);
+        void deallocateMapping(void* pointer, std::size_t bytes) noexcept;
+    }
+
+    // An allocator for the big planes of mega boards. With HugePageMode off, the default, it is plain operator new.
+    // Otherwise allocations of a huge page or more are mapped directly and advised or reserved as huge pages, and
+    // where huge pages aren't available it quietly falls back to ordinary pages.
+    template<typename T>
+    class HugePageAllocator {
+    public:
+        using value_type = T;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+
+        HugePageAllocator() noexcept : m_mode{getHugePageMode()} { }
+        template<typename U>
+        HugePageAllocator(const HugePageAllocator<U>& other) noexcept : m_mode{other.getMode()} { }
+
+        [[nodiscard]] T* allocate(std::size_t amount);
+        void deallocate(T* pointer, std::size_t amount) noexcept;
+
+        [[nodiscard]] HugePageMode getMode() const noexcept { return m_mode; }
+
+        // both kinds of huge page are unmapped alike, so only off differs from the rest
+        template<typename U>
+        bool operator==(const HugePageAllocator<U>& other) const noexcept {
+            return (m_mode == HugePageMode::off) == (other.getMode() == HugePageMode::off);
+        }
+
+    private:
+        HugePageMode m_mode;
+
+        [[nodiscard]] bool mapped(std::size_t bytes) const noexcept;
+    };
+
+    template<typename T>
+    bool HugePageAllocator<T>::mapped(const std::size_t bytes) const noexcept {
+        return m_mode != HugePageMode::off && bytes >= detail::hugePageThreshold;
+    }
+
+    template<typename T>
+    T* HugePageAllocator<T>::allocate(const std::size_t amount) {
+        const std::size_t bytes{amount * sizeof(T)};
+        if (!mapped(bytes)) {
+            return static_cast<T*>(::operator new(bytes, std::align_val_t{alignof(T)}));
+        }
+        return static_cast<T*>(detail::allocateMapping(bytes, m_mode));
+    }
+
+    template<typename T>
+    void HugePageAllocator<T>::deallocate(T* pointer, const std::size_t amount) noexcept {
+        const std::size_t bytes{amount * sizeof(T)};
+        if (!mapped(bytes)) {
+            ::operator delete(pointer, std::align_val_t{alignof(T)});
+            return;
+        }
+        detail::deallocateMapping(pointer, bytes);
+    }
+} // Minesweeper
+
+#endif //HUGEPAGEALLOCATOR_HPP
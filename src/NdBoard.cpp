@@ -0,0 +1,539 @@
+#include "NdBoard.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <functional>
+#include <numeric>
+#ifndef _MSC_VER
+#define PCG_RAND
+#include <pcg/pcg_extras.hpp>
+#include <pcg/pcg_random.hpp>
+#endif
+#include <random>
+
+namespace Minesweeper {
+    template<std::size_t Dimensions>
+    NdBoard<Dimensions>::NdBoard(const Coordinates& extents,
+                                 const std::uint32_t mineCount): m_extents{extents},
+                                                                 m_tileAmount{
+                                                                     std::accumulate(
+                                                                         extents.begin(), extents.end(),
+                                                                         std::size_t{1}, std::multiplies{})
+                                                                 },
+                                                                 m_lineAmount{m_tileAmount / extents[0]},
+                                                                 m_wordsPerLine{(extents[0] + 63u) / 64u},
+                                                                 m_blockRows{(extents[1] + blockSide - 1) / blockSide},
+                                                                 m_blockAmount{
+                                                                     m_lineAmount / extents[1] * m_blockRows
+                                                                     * m_wordsPerLine
+                                                                 },
+                                                                 m_uncheckedSafeAmount{m_tileAmount - mineCount},
+                                                                 m_mineCount{mineCount} {
+        assert(mineCount < m_tileAmount);
+        const std::size_t wordAmount{m_lineAmount * m_wordsPerLine};
+        m_mines.resize(wordAmount);
+        m_checked.resize(wordAmount);
+        m_flagged.resize(wordAmount);
+        m_zeros.resize(wordAmount);
+        const std::size_t summaryWords{(m_blockAmount + 63) / 64};
+        m_blockRevealed.resize(m_blockAmount);
+        m_blockSafe.resize(m_blockAmount);
+        m_allRevealedBlocks.resize(summaryWords);
+        m_unrevealedBlocks.resize(summaryWords, ~std::uint64_t{0});
+        m_unrevealedBlocks.back() >>= summaryWords * 64 - m_blockAmount;
+        m_frontierBlocks.resize(summaryWords);
+        m_dirtyBlocks.resize(summaryWords);
+        std::size_t stride{1};
+        for (std::size_t axis{0}; axis < Dimensions; axis++) {
+            m_strides[axis] = stride;
+            stride *= m_extents[axis];
+        }
+        // enumerate {-1, 0, 1}^N in base 3, skipping the all-zero step which is the tile itself
+        std::size_t neighbour{0};
+        for (std::size_t code{0}; code < maxNeighbours + 1; code++) {
+            std::array<std::int8_t, Dimensions> steps{};
+            std::ptrdiff_t offset{0};
+            bool isSelf{true};
+            std::size_t remaining{code};
+            for (std::size_t axis{0}; axis < Dimensions; axis++) {
+                steps[axis] = static_cast<std::int8_t>(remaining % 3) - 1;
+                remaining /= 3;
+                offset += steps[axis] * static_cast<std::ptrdiff_t>(m_strides[axis]);
+                isSelf = isSelf && steps[axis] == 0;
+            }
+            if (isSelf) {
+                continue;
+            }
+            m_neighbourSteps[neighbour] = steps;
+            m_neighbourOffsets[neighbour] = offset;
+            neighbour++;
+        }
+        // the same enumeration over every axis but the first gives the lines bordering a line, itself included
+        for (std::size_t code{0}; code < lineNeighbourhood; code++) {
+            std::ptrdiff_t offset{0};
+            std::ptrdiff_t lineStride{1};
+            std::size_t remaining{code};
+            for (std::size_t axis{1}; axis < Dimensions; axis++) {
+                m_lineSteps[code][axis] = static_cast<std::int8_t>(remaining % 3) - 1;
+                remaining /= 3;
+                offset += m_lineSteps[code][axis] * lineStride;
+                lineStride *= m_extents[axis];
+            }
+            m_lineOffsets[code] = offset;
+        }
+    }
+
+    template<std::size_t Dimensions>
+    void NdBoard<Dimensions>::checkTile(const Coordinates& coordinates) {
+        const std::size_t index{toLinear(coordinates)};
+        if (testBit(m_flagged, index)) {
+            return;
+        }
+        if (m_firstCheck) {
+            generateMines(index);
+            m_firstCheck = false;
+        }
+        reveal(index);
+        refreshSummaries();
+    }
+
+    template<std::size_t Dimensions>
+    void NdBoard<Dimensions>::toggleFlag(const Coordinates& coordinates) noexcept {
+        const std::size_t index{toLinear(coordinates)};
+        if (testBit(m_checked, index)) {
+            return;
+        }
+        if (!testBit(m_flagged, index)) {
+            m_flagCount++;
+        } else {
+            m_flagCount--;
+        }
+        flipBit(m_flagged, index);
+    }
+
+    template<std::size_t Dimensions>
+    void NdBoard<Dimensions>::clearSafeTiles(const Coordinates& coordinates) {
+        const std::size_t index{toLinear(coordinates)};
+        const std::uint8_t count{countAt(index)};
+        if (!testBit(m_checked, index) || count == 0) {
+            return;
+        }
+        std::uint8_t flagAmount{0};
+        forEachNeighbour(index, [&](const std::size_t neighbour) {
+            flagAmount += testBit(m_flagged, neighbour);
+        });
+        if (flagAmount != count) {
+            return;
+        }
+        forEachNeighbour(index, [&](const std::size_t neighbour) {
+            reveal(neighbour);
+        });
+        refreshSummaries();
+    }
+
+    template<std::size_t Dimensions>
+    void NdBoard<Dimensions>::reveal(const std::size_t index) {
+        if (testBit(m_checked, index) || testBit(m_flagged, index)) {
+            return;
+        }
+        markRevealed(index / m_extents[0], index % m_extents[0] / 64, std::uint64_t{1} << (index % m_extents[0] % 64));
+        if (testBit(m_mines, index)) {
+            m_hitMine = true;
+            return;
+        }
+        if (testBit(m_zeros, index)) {
+            floodFill(index / m_extents[0]);
+        }
+    }
+
+    template<std::size_t Dimensions>
+    void NdBoard<Dimensions>::floodFill(const std::size_t line) {
+        // Works on whole lines: settle the line along the first axis, carrying from word to word, then dilate its
+        // revealed zeros into every bordering line at once. A line is queued in a bitset whenever it gains a zero,
+        // and the queue is swept in memory order, forwards and backwards in turn, so an opening spreading along
+        // the other axes is mostly handled within one sweep instead of bouncing lines around a stack.
+        std::vector<std::uint64_t> queued((m_lineAmount + 63) / 64, 0);
+        queued[line / 64] |= std::uint64_t{1} << line % 64;
+        std::size_t queuedAmount{1};
+        // which blocks border the new tiles is settled once per line at the end rather than once per word
+        std::vector<std::uint64_t> touched((m_lineAmount * m_wordsPerLine + 63) / 64, 0);
+        const auto revealWord{[&](const std::size_t revealedLine, const std::size_t word, const std::uint64_t bits) {
+            setRevealed(revealedLine, word, bits);
+            const std::size_t position{revealedLine * m_wordsPerLine + word};
+            touched[position / 64] |= std::uint64_t{1} << position % 64;
+            if (word > 0 && (bits & 1) != 0) {
+                touched[(position - 1) / 64] |= std::uint64_t{1} << (position - 1) % 64;
+            }
+            if (word + 1 < m_wordsPerLine && bits >> 63 != 0) {
+                touched[(position + 1) / 64] |= std::uint64_t{1} << (position + 1) % 64;
+            }
+        }};
+        std::vector<std::uint64_t> grown(m_wordsPerLine);
+        std::vector<std::uint64_t> dilated(m_wordsPerLine);
+        const auto settleWord{[&](const std::size_t position, const std::uint64_t revealed,
+                                  const std::uint64_t available) {
+            // fill the runs of zeros holding a revealed one both ways in six doubling steps, then reveal their rims
+            const std::uint64_t passable{m_zeros[position] & available};
+            std::uint64_t upwards{revealed & passable};
+            std::uint64_t downwards{upwards};
+            std::uint64_t upwardsPassable{passable};
+            std::uint64_t downwardsPassable{passable};
+            for (unsigned shift{1}; shift < 64; shift *= 2) {
+                upwards |= upwardsPassable & upwards << shift;
+                upwardsPassable &= upwardsPassable << shift;
+                downwards |= downwardsPassable & downwards >> shift;
+                downwardsPassable &= downwardsPassable >> shift;
+            }
+            const std::uint64_t zeros{upwards | downwards};
+            return revealed | ((zeros | zeros << 1 | zeros >> 1) & available);
+        }};
+        const auto visit{[&](const std::size_t current) {
+            const std::size_t first{current * m_wordsPerLine};
+            // rightwards and then leftwards; what the way back reveals lies left of zeros already revealed, so it
+            // has nothing left to give to the right
+            std::uint64_t carry{0};
+            for (std::size_t word{0}; word < m_wordsPerLine; word++) {
+                const std::uint64_t available{~m_flagged[first + word] & validBits(word)};
+                grown[word] = settleWord(first + word, m_checked[first + word] | (carry & available), available);
+                carry = (grown[word] & m_zeros[first + word]) >> 63;
+            }
+            carry = 0;
+            for (std::size_t word{m_wordsPerLine}; word-- > 0;) {
+                const std::uint64_t available{~m_flagged[first + word] & validBits(word)};
+                grown[word] = settleWord(first + word, grown[word] | (carry << 63 & available), available);
+                carry = grown[word] & m_zeros[first + word] & 1;
+            }
+            bool spreading{false};
+            for (std::size_t word{0}; word < m_wordsPerLine; word++) {
+                if (grown[word] != m_checked[first + word]) {
+                    revealWord(current, word, grown[word] & ~m_checked[first + word]);
+                }
+                const std::uint64_t zeros{grown[word] & m_zeros[first + word]};
+                dilated[word] = zeros | zeros << 1 | zeros >> 1;
+                if (word > 0) {
+                    dilated[word - 1] |= zeros << 63;
+                    dilated[word] |= (grown[word - 1] & m_zeros[first + word - 1]) >> 63;
+                }
+                spreading |= zeros != 0;
+            }
+            if (!spreading) {
+                return;
+            }
+            forEachBorderingLine(current, [&](const std::size_t target) {
+                if (target == current) {
+                    return;
+                }
+                const std::size_t targetFirst{target * m_wordsPerLine};
+                bool gainedZero{false};
+                for (std::size_t word{0}; word < m_wordsPerLine; word++) {
+                    const std::size_t position{targetFirst + word};
+                    const std::uint64_t newlyChecked{
+                        dilated[word] & ~m_checked[position] & ~m_flagged[position] & validBits(word)
+                    };
+                    if (newlyChecked != 0) {
+                        revealWord(target, word, newlyChecked);
+                        gainedZero |= (newlyChecked & m_zeros[position]) != 0;
+                    }
+                }
+                if (gainedZero && (queued[target / 64] >> target % 64 & 1) == 0) {
+                    queued[target / 64] |= std::uint64_t{1} << target % 64;
+                    queuedAmount++;
+                }
+            });
+        }};
+        for (bool forwards{true}; queuedAmount > 0; forwards = !forwards) {
+            for (std::size_t step{0}; step < queued.size(); step++) {
+                const std::size_t group{forwards ? step : queued.size() - 1 - step};
+                while (queued[group] != 0) {
+                    const auto bit{static_cast<std::size_t>(
+                        forwards ? std::countr_zero(queued[group]) : 63 - std::countl_zero(queued[group])
+                    )};
+                    queued[group] &= ~(std::uint64_t{1} << bit);
+                    queuedAmount--;
+                    visit(group * 64 + bit);
+                }
+            }
+        }
+        std::vector<std::size_t> words;
+        std::size_t touchedLine{m_lineAmount};
+        const auto markLine{[&] {
+            if (touchedLine < m_lineAmount) {
+                forEachBorderingLine(touchedLine, [&](const std::size_t borderingLine) {
+                    for (const std::size_t word: words) {
+                        markDirty(blockOf(borderingLine, word));
+                    }
+                });
+            }
+            words.clear();
+        }};
+        for (std::size_t group{0}; group < touched.size(); group++) {
+            for (std::uint64_t bits{touched[group]}; bits != 0; bits &= bits - 1) {
+                const std::size_t position{group * 64 + static_cast<std::size_t>(std::countr_zero(bits))};
+                if (position / m_wordsPerLine != touchedLine) {
+                    markLine();
+                    touchedLine = position / m_wordsPerLine;
+                }
+                words.push_back(position % m_wordsPerLine);
+            }
+        }
+        markLine();
+    }
+
+    template<std::size_t Dimensions>
+    template<typename Function>
+    void NdBoard<Dimensions>::forEachBorderingLine(const std::size_t line, Function&& function) const {
+        std::array<std::size_t, Dimensions> lineCoordinates{};
+        std::size_t remaining{line};
+        for (std::size_t axis{1}; axis < Dimensions; axis++) {
+            lineCoordinates[axis] = remaining % m_extents[axis];
+            remaining /= m_extents[axis];
+        }
+        for (std::size_t neighbour{0}; neighbour < lineNeighbourhood; neighbour++) {
+            bool inBounds{true};
+            for (std::size_t axis{1}; axis < Dimensions; axis++) {
+                const std::int8_t step{m_lineSteps[neighbour][axis]};
+                inBounds = inBounds && !(step < 0 && lineCoordinates[axis] == 0)
+                           && !(step > 0 && lineCoordinates[axis] + 1 == m_extents[axis]);
+            }
+            if (inBounds) {
+                function(static_cast<std::size_t>(static_cast<std::ptrdiff_t>(line) + m_lineOffsets[neighbour]));
+            }
+        }
+    }
+
+    template<std::size_t Dimensions>
+    void NdBoard<Dimensions>::setRevealed(const std::size_t line, const std::size_t word,
+                                          const std::uint64_t bits) noexcept {
+        const std::size_t position{line * m_wordsPerLine + word};
+        m_checked[position] |= bits;
+        const auto safeAmount{static_cast<std::uint16_t>(std::popcount(bits & ~m_mines[position]))};
+        m_uncheckedSafeAmount -= safeAmount;
+        m_blockRevealed[blockOf(line, word)] += safeAmount;
+    }
+
+    template<std::size_t Dimensions>
+    void NdBoard<Dimensions>::markRevealed(const std::size_t line, const std::size_t word, const std::uint64_t bits) {
+        setRevealed(line, word, bits);
+        // the frontier of every block within one tile of the new bits may have changed
+        forEachBorderingLine(line, [&](const std::size_t borderingLine) {
+            markDirty(blockOf(borderingLine, word));
+            if (word > 0 && (bits & 1) != 0) {
+                markDirty(blockOf(borderingLine, word - 1));
+            }
+            if (word + 1 < m_wordsPerLine && bits >> 63 != 0) {
+                markDirty(blockOf(borderingLine, word + 1));
+            }
+        });
+    }
+
+    template<std::size_t Dimensions>
+    void NdBoard<Dimensions>::markDirty(const std::size_t block) {
+        std::uint64_t& word{m_dirtyBlocks[block / 64]};
+        const std::uint64_t mask{std::uint64_t{1} << (block % 64)};
+        if ((word & mask) == 0) {
+            word |= mask;
+            m_dirtyBlockList.push_back(block);
+        }
+    }
+
+    template<std::size_t Dimensions>
+    void NdBoard<Dimensions>::refreshSummaries() {
+        for (const std::size_t block: m_dirtyBlockList) {
+            const std::uint64_t mask{std::uint64_t{1} << (block % 64)};
+            m_dirtyBlocks[block / 64] &= ~mask;
+            auto assign = [&](std::vector<std::uint64_t>& summary, const bool value) {
+                summary[block / 64] = value ? summary[block / 64] | mask : summary[block / 64] & ~mask;
+            };
+            assign(m_allRevealedBlocks, m_blockRevealed[block] == m_blockSafe[block]);
+            assign(m_unrevealedBlocks, m_blockRevealed[block] == 0);
+            assign(m_frontierBlocks, computeFrontier(block));
+        }
+        m_dirtyBlockList.clear();
+    }
+
+    template<std::size_t Dimensions>
+    bool NdBoard<Dimensions>::computeFrontier(const std::size_t block) const {
+        // dilate the revealed tiles of every bordering line into each line of the block, one word at a time, and
+        // stop at the first unrevealed tile they reach
+        const std::size_t word{block % m_wordsPerLine};
+        const std::size_t blockRow{block / m_wordsPerLine % m_blockRows};
+        const std::size_t layer{block / m_wordsPerLine / m_blockRows};
+        const std::size_t firstLine{layer * m_extents[1] + blockRow * blockSide};
+        const std::size_t lastLine{std::min(firstLine + blockSide, (layer + 1) * m_extents[1])};
+        for (std::size_t line{firstLine}; line < lastLine; line++) {
+            const std::uint64_t unrevealed{~m_checked[line * m_wordsPerLine + word] & validBits(word)};
+            if (unrevealed == 0) {
+                continue;
+            }
+            std::uint64_t reached{0};
+            forEachBorderingLine(line, [&](const std::size_t borderingLine) {
+                const std::size_t position{borderingLine * m_wordsPerLine + word};
+                const std::uint64_t checked{m_checked[position]};
+                reached |= checked | checked << 1 | checked >> 1;
+                if (word > 0) {
+                    reached |= m_checked[position - 1] >> 63;
+                }
+                if (word + 1 < m_wordsPerLine) {
+                    reached |= m_checked[position + 1] << 63;
+                }
+            });
+            if ((reached & unrevealed) != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template<std::size_t Dimensions>
+    template<typename Function>
+    void NdBoard<Dimensions>::forEachNeighbour(const std::size_t index, Function&& function) const {
+        std::array<std::uint16_t, Dimensions> coordinates{};
+        for (std::size_t axis{0}; axis < Dimensions; axis++) {
+            coordinates[axis] = static_cast<std::uint16_t>(index / m_strides[axis] % m_extents[axis]);
+        }
+        for (std::size_t neighbour{0}; neighbour < maxNeighbours; neighbour++) {
+            bool inBounds{true};
+            for (std::size_t axis{0}; axis < Dimensions; axis++) {
+                const std::int8_t step{m_neighbourSteps[neighbour][axis]};
+                inBounds = inBounds && !(step < 0 && coordinates[axis] == 0)
+                           && !(step > 0 && coordinates[axis] + 1 == m_extents[axis]);
+            }
+            if (inBounds) {
+                function(static_cast<std::size_t>(static_cast<std::ptrdiff_t>(index) + m_neighbourOffsets[neighbour]));
+            }
+        }
+    }
+
+    template<std::size_t Dimensions>
+    void NdBoard<Dimensions>::generateMines(const std::size_t index) {
+        std::vector<std::size_t> safeTiles{index};
+        forEachNeighbour(index, [&](const std::size_t neighbour) {
+            safeTiles.push_back(neighbour);
+        });
+        if (m_mineCount >= m_tileAmount - safeTiles.size()) [[unlikely]] {
+            safeTiles.resize(1);
+        }
+        std::ranges::sort(safeTiles);
+        #ifdef PCG_RAND
+        assert(m_tileAmount <= UINT32_MAX);
+        pcg32_fast rng{
+            m_seed.has_value() ? pcg32_fast{*m_seed} : pcg32_fast{pcg_extras::seed_seq_from<std::random_device>()}
+        };
+        auto randomIndex = [&] { return static_cast<std::size_t>(rng(static_cast<std::uint32_t>(m_tileAmount))); };
+        #else
+        std::random_device rand;
+        std::seed_seq seedSeq{rand(), rand(), rand(), rand(), rand(), rand(), rand(), rand()};
+        std::mt19937_64 rng{
+            m_seed.has_value() ? std::mt19937_64{*m_seed} : std::mt19937_64{seedSeq}
+        };
+        std::uniform_int_distribution<std::size_t> distribution(0, m_tileAmount - 1);
+        auto randomIndex = [&] { return distribution(rng); };
+        #endif
+        // rejection sampling stays fast while at most half the candidates get picked, so dense boards pick the
+        // tiles that stay free instead and invert
+        const std::size_t candidateAmount{m_tileAmount - safeTiles.size()};
+        const bool invert{m_mineCount > candidateAmount / 2};
+        const std::size_t pickAmount{invert ? candidateAmount - m_mineCount : m_mineCount};
+        Plane picked(m_mines.size());
+        for (std::size_t pickedAmount{0}; pickedAmount < pickAmount;) {
+            const std::size_t candidate{randomIndex()};
+            if (testBit(picked, candidate) || std::ranges::binary_search(safeTiles, candidate)) {
+                continue;
+            }
+            setBit(picked, candidate);
+            pickedAmount++;
+        }
+        if (invert) {
+            for (std::size_t position{0}; position < picked.size(); position++) {
+                picked[position] = ~picked[position] & validBits(position % m_wordsPerLine);
+            }
+            for (const std::size_t safeTile: safeTiles) {
+                flipBit(picked, safeTile);
+            }
+        }
+        m_mines = std::move(picked);
+        computeCounts();
+        for (std::size_t line{0}; line < m_lineAmount; line++) {
+            for (std::size_t word{0}; word < m_wordsPerLine; word++) {
+                m_blockSafe[blockOf(line, word)] += static_cast<std::uint16_t>(
+                    std::popcount(~m_mines[line * m_wordsPerLine + word] & validBits(word)));
+            }
+        }
+        for (std::size_t block{0}; block < m_blockAmount; block++) {
+            if (m_blockSafe[block] == 0) {
+                markDirty(block);
+            }
+        }
+    }
+
+    // adds one bit-sliced number of 64 tiles into another, carrying from each bit to the next
+    template<std::size_t Bits>
+    static void addSliced(std::array<std::uint64_t, Bits>& total, const std::uint64_t* addend) noexcept {
+        std::uint64_t carry{0};
+        for (std::size_t b{0}; b < Bits; b++) {
+            const std::uint64_t sum{total[b] ^ addend[b]};
+            const std::uint64_t nextCarry{(total[b] & addend[b]) | (carry & sum)};
+            total[b] = sum ^ carry;
+            carry = nextCarry;
+        }
+    }
+
+    template<std::size_t Dimensions>
+    void NdBoard<Dimensions>::computeCounts() {
+        // A full adder of every mine word with its shifts along the first axis gives two-bit sums of three tiles;
+        // each further axis adds the sums of the lines before and after, and the box, tile included, ends up in
+        // countBits words per word of tiles. The tile's own mine comes back off at the end.
+        const std::size_t wordAmount{m_lineAmount * m_wordsPerLine};
+        Plane sums(wordAmount * countBits);
+        for (std::size_t position{0}; position < wordAmount; position++) {
+            const std::size_t word{position % m_wordsPerLine};
+            const std::uint64_t mines{m_mines[position]};
+            const std::uint64_t before{
+                (mines << 1 | (word > 0 ? m_mines[position - 1] >> 63 : 0)) & validBits(word)
+            };
+            const std::uint64_t after{mines >> 1 | (word + 1 < m_wordsPerLine ? m_mines[position + 1] << 63 : 0)};
+            sums[position * countBits] = before ^ mines ^ after;
+            sums[position * countBits + 1] = (before & mines) | (after & (before ^ mines));
+        }
+        Plane scratch(sums.size());
+        for (std::size_t axis{1}; axis < Dimensions; axis++) {
+            const std::size_t lineStride{m_strides[axis] / m_extents[0]};
+            const std::size_t wordStride{lineStride * m_wordsPerLine * countBits};
+            for (std::size_t line{0}; line < m_lineAmount; line++) {
+                const std::size_t coordinate{line / lineStride % m_extents[axis]};
+                const bool hasPrevious{coordinate > 0};
+                const bool hasNext{coordinate + 1 < m_extents[axis]};
+                for (std::size_t position{line * m_wordsPerLine}; position < (line + 1) * m_wordsPerLine; position++) {
+                    const std::uint64_t* own{&sums[position * countBits]};
+                    std::array<std::uint64_t, countBits> total{};
+                    std::copy_n(own, countBits, total.begin());
+                    if (hasPrevious) {
+                        addSliced(total, own - wordStride);
+                    }
+                    if (hasNext) {
+                        addSliced(total, own + wordStride);
+                    }
+                    std::ranges::copy(total, scratch.begin() + static_cast<std::ptrdiff_t>(position * countBits));
+                }
+            }
+            sums.swap(scratch);
+        }
+        for (std::size_t position{0}; position < wordAmount; position++) {
+            const std::uint64_t mines{m_mines[position]};
+            std::uint64_t borrow{mines};
+            std::uint64_t counted{0};
+            for (std::size_t b{0}; b < countBits; b++) {
+                const std::uint64_t bit{sums[position * countBits + b] ^ borrow};
+                borrow &= bit;
+                sums[position * countBits + b] = bit;
+                counted |= bit;
+            }
+            m_zeros[position] = ~counted & ~mines & validBits(position % m_wordsPerLine);
+        }
+        m_counts = std::move(sums);
+    }
+
+    template class NdBoard<2>;
+    template class NdBoard<3>;
+} // Minesweeper
@@ -0,0 +1,281 @@
+#ifndef NDBOARD_HPP
+#define NDBOARD_HPP
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "HugePageAllocator.hpp"
+
+
+namespace Minesweeper {
+    namespace detail {
+        constexpr std::size_t boxVolume(const std::size_t dimensions) {
+            std::size_t volume{1};
+            for (std::size_t i{0}; i < dimensions; i++) {
+                volume *= 3;
+            }
+            return volume;
+        }
+    }
+
+    // A board of any number of dimensions where every tile touches the up to 3^N - 1 tiles of its enclosing box.
+    // Mines, checks, flags and zero tiles are stored as bit planes with every line along the first axis padded to
+    // whole words, all allocated through HugePageAllocator. The counts are bit-sliced as well: a separable box sum
+    // of full adders over the mine words, one pass per axis, leaves each count bit of 64 tiles in one word, and
+    // the zero plane is what no count bit is set in. Openings are flood filled a whole line at a time.
+    //
+    // On top of the tile planes sits a summary level: the tiles are grouped into blocks of 64 x 64 over the first
+    // two axes, and one bit per block records whether all of its safe tiles are revealed, none of its tiles are,
+    // and whether it holds frontier tiles (unrevealed tiles next to a revealed one). Reveals update only the blocks
+    // they touch, so the per-move bookkeeping is independent of the board size and callers can skip whole blocks.
+    template<std::size_t Dimensions>
+    class NdBoard final {
+        static_assert(Dimensions >= 2, "summary blocks span the first two axes");
+
+    public:
+        using Coordinates = std::array<std::uint16_t, Dimensions>;
+        using Plane = std::vector<std::uint64_t, HugePageAllocator<std::uint64_t> >;
+
+        static constexpr std::size_t maxNeighbours{detail::boxVolume(Dimensions) - 1};
+        static constexpr std::size_t blockSide{64};
+
+    private:
+        static constexpr std::size_t lineNeighbourhood{detail::boxVolume(Dimensions - 1)}; // includes the line itself
+        static constexpr std::size_t countBits{std::bit_width(detail::boxVolume(Dimensions))}; // the box, tile included
+
+        Plane m_mines;
+        Plane m_checked;
+        Plane m_flagged;
+        Plane m_zeros;
+        Plane m_counts; // bit b of the counts of a word's tiles at word * countBits + b
+        std::vector<std::uint16_t> m_blockRevealed;
+        std::vector<std::uint16_t> m_blockSafe;
+        std::vector<std::uint64_t> m_allRevealedBlocks;
+        std::vector<std::uint64_t> m_unrevealedBlocks;
+        std::vector<std::uint64_t> m_frontierBlocks;
+        std::vector<std::uint64_t> m_dirtyBlocks;
+        std::vector<std::size_t> m_dirtyBlockList;
+        std::array<std::size_t, Dimensions> m_strides{};
+        std::array<std::ptrdiff_t, maxNeighbours> m_neighbourOffsets{};
+        std::array<std::array<std::int8_t, Dimensions>, maxNeighbours> m_neighbourSteps{};
+        std::array<std::ptrdiff_t, lineNeighbourhood> m_lineOffsets{};
+        std::array<std::array<std::int8_t, Dimensions>, lineNeighbourhood> m_lineSteps{};
+        const Coordinates m_extents;
+        const std::size_t m_tileAmount;
+        const std::size_t m_lineAmount;
+        const std::size_t m_wordsPerLine;
+        const std::size_t m_blockRows; // blocks along the second axis
+        const std::size_t m_blockAmount;
+        std::size_t m_uncheckedSafeAmount;
+        const std::uint32_t m_mineCount;
+        std::uint32_t m_flagCount{0};
+        std::optional<std::uint64_t> m_seed{};
+        bool m_firstCheck{true};
+        bool m_hitMine{false};
+
+        template<typename Function>
+        void forEachNeighbour(std::size_t index, Function&& function) const;
+        void generateMines(std::size_t index);
+        void computeCounts();
+        void reveal(std::size_t index);
+        void floodFill(std::size_t line);
+        void markRevealed(std::size_t line, std::size_t word, std::uint64_t bits);
+        void setRevealed(std::size_t line, std::size_t word, std::uint64_t bits) noexcept;
+        void markDirty(std::size_t block);
+        void refreshSummaries();
+        [[nodiscard]] bool computeFrontier(std::size_t block) const;
+        template<typename Function>
+        void forEachBorderingLine(std::size_t line, Function&& function) const;
+        [[nodiscard]] std::size_t blockOf(std::size_t line, std::size_t word) const noexcept;
+        [[nodiscard]] std::uint64_t validBits(std::size_t word) const noexcept;
+        [[nodiscard]] std::size_t toLinear(const Coordinates& coordinates) const noexcept;
+        [[nodiscard]] std::size_t wordOf(std::size_t index) const noexcept;
+        [[nodiscard]] std::uint8_t countAt(std::size_t index) const noexcept;
+        [[nodiscard]] bool testBit(const Plane& plane, std::size_t index) const noexcept;
+        void setBit(Plane& plane, std::size_t index) const noexcept;
+        void flipBit(Plane& plane, std::size_t index) const noexcept;
+
+    public:
+        explicit NdBoard(const Coordinates& extents, std::uint32_t mineCount);
+        [[nodiscard]] const Coordinates& getExtents() const noexcept;
+        [[nodiscard]] std::uint32_t getMineCount() const noexcept;
+        [[nodiscard]] std::int64_t getRemainingMines() const noexcept;
+        [[nodiscard]] bool foundAllMines() const noexcept;
+        [[nodiscard]] bool hitMine() const noexcept;
+        [[nodiscard]] bool isChecked(const Coordinates& coordinates) const noexcept;
+        [[nodiscard]] bool isFlagged(const Coordinates& coordinates) const noexcept;
+        [[nodiscard]] bool isMine(const Coordinates& coordinates) const noexcept;
+        [[nodiscard]] std::uint8_t getSurroundingMines(const Coordinates& coordinates) const noexcept;
+        void checkTile(const Coordinates& coordinates);
+        void toggleFlag(const Coordinates& coordinates) noexcept;
+        void clearSafeTiles(const Coordinates& coordinates);
+        void setSeed(std::uint64_t seed) noexcept;
+        [[nodiscard]] std::size_t getBlockAmount() const noexcept;
+        [[nodiscard]] std::size_t blockOf(const Coordinates& coordinates) const noexcept;
+        [[nodiscard]] bool isBlockAllRevealed(std::size_t block) const noexcept;
+        [[nodiscard]] bool isBlockUnrevealed(std::size_t block) const noexcept;
+        [[nodiscard]] bool blockHasFrontier(std::size_t block) const noexcept;
+        [[nodiscard]] std::size_t getAllRevealedBlockAmount() const noexcept;
+        template<typename Function>
+        void forEachFrontierBlock(Function&& function) const;
+    };
+
+    using VolumeBoard = NdBoard<3>;
+
+    template<std::size_t Dimensions>
+    inline const typename NdBoard<Dimensions>::Coordinates& NdBoard<Dimensions>::getExtents() const noexcept {
+        return m_extents;
+    }
+
+    template<std::size_t Dimensions>
+    inline std::uint32_t NdBoard<Dimensions>::getMineCount() const noexcept {
+        return m_mineCount;
+    }
+
+    template<std::size_t Dimensions>
+    inline std::int64_t NdBoard<Dimensions>::getRemainingMines() const noexcept {
+        return static_cast<std::int64_t>(m_mineCount) - m_flagCount;
+    }
+
+    template<std::size_t Dimensions>
+    inline bool NdBoard<Dimensions>::foundAllMines() const noexcept {
+        return m_uncheckedSafeAmount == 0 && !m_hitMine;
+    }
+
+    template<std::size_t Dimensions>
+    inline bool NdBoard<Dimensions>::hitMine() const noexcept {
+        return m_hitMine;
+    }
+
+    template<std::size_t Dimensions>
+    inline bool NdBoard<Dimensions>::isChecked(const Coordinates& coordinates) const noexcept {
+        return testBit(m_checked, toLinear(coordinates));
+    }
+
+    template<std::size_t Dimensions>
+    inline bool NdBoard<Dimensions>::isFlagged(const Coordinates& coordinates) const noexcept {
+        return testBit(m_flagged, toLinear(coordinates));
+    }
+
+    template<std::size_t Dimensions>
+    inline bool NdBoard<Dimensions>::isMine(const Coordinates& coordinates) const noexcept {
+        return testBit(m_mines, toLinear(coordinates));
+    }
+
+    template<std::size_t Dimensions>
+    inline std::uint8_t NdBoard<Dimensions>::getSurroundingMines(const Coordinates& coordinates) const noexcept {
+        return countAt(toLinear(coordinates));
+    }
+
+    template<std::size_t Dimensions>
+    inline void NdBoard<Dimensions>::setSeed(const std::uint64_t seed) noexcept {
+        m_seed = seed;
+    }
+
+    template<std::size_t Dimensions>
+    inline std::size_t NdBoard<Dimensions>::getBlockAmount() const noexcept {
+        return m_blockAmount;
+    }
+
+    template<std::size_t Dimensions>
+    inline std::size_t NdBoard<Dimensions>::blockOf(const Coordinates& coordinates) const noexcept {
+        const std::size_t index{toLinear(coordinates)};
+        return blockOf(index / m_extents[0], index % m_extents[0] / 64);
+    }
+
+    template<std::size_t Dimensions>
+    inline bool NdBoard<Dimensions>::isBlockAllRevealed(const std::size_t block) const noexcept {
+        return m_allRevealedBlocks[block / 64] >> (block % 64) & 1;
+    }
+
+    template<std::size_t Dimensions>
+    inline bool NdBoard<Dimensions>::isBlockUnrevealed(const std::size_t block) const noexcept {
+        return m_unrevealedBlocks[block / 64] >> (block % 64) & 1;
+    }
+
+    template<std::size_t Dimensions>
+    inline bool NdBoard<Dimensions>::blockHasFrontier(const std::size_t block) const noexcept {
+        return m_frontierBlocks[block / 64] >> (block % 64) & 1;
+    }
+
+    template<std::size_t Dimensions>
+    inline std::size_t NdBoard<Dimensions>::getAllRevealedBlockAmount() const noexcept {
+        std::size_t amount{0};
+        for (const std::uint64_t word: m_allRevealedBlocks) {
+            amount += std::popcount(word);
+        }
+        return amount;
+    }
+
+    template<std::size_t Dimensions>
+    template<typename Function>
+    void NdBoard<Dimensions>::forEachFrontierBlock(Function&& function) const {
+        for (std::size_t word{0}; word < m_frontierBlocks.size(); word++) {
+            for (std::uint64_t bits{m_frontierBlocks[word]}; bits != 0; bits &= bits - 1) {
+                function(word * 64 + std::countr_zero(bits));
+            }
+        }
+    }
+
+    template<std::size_t Dimensions>
+    inline std::size_t NdBoard<Dimensions>::blockOf(const std::size_t line, const std::size_t word) const noexcept {
+        // the block grid is words along the first axis, then blocks of lines along the second, then every layer
+        const std::size_t layer{line / m_extents[1]};
+        return (layer * m_blockRows + line % m_extents[1] / blockSide) * m_wordsPerLine + word;
+    }
+
+    template<std::size_t Dimensions>
+    inline std::size_t NdBoard<Dimensions>::toLinear(const Coordinates& coordinates) const noexcept {
+        std::size_t index{0};
+        for (std::size_t axis{0}; axis < Dimensions; axis++) {
+            index += coordinates[axis] * m_strides[axis];
+        }
+        return index;
+    }
+
+    template<std::size_t Dimensions>
+    inline std::size_t NdBoard<Dimensions>::wordOf(const std::size_t index) const noexcept {
+        return index / m_extents[0] * m_wordsPerLine + index % m_extents[0] / 64;
+    }
+
+    template<std::size_t Dimensions>
+    inline std::uint8_t NdBoard<Dimensions>::countAt(const std::size_t index) const noexcept {
+        if (m_counts.empty()) {
+            return 0;
+        }
+        const std::size_t first{wordOf(index) * countBits};
+        const std::size_t bit{index % m_extents[0] % 64};
+        std::uint8_t count{0};
+        for (std::size_t b{0}; b < countBits; b++) {
+            count |= static_cast<std::uint8_t>((m_counts[first + b] >> bit & 1) << b);
+        }
+        return count;
+    }
+
+    template<std::size_t Dimensions>
+    inline bool NdBoard<Dimensions>::testBit(const Plane& plane, const std::size_t index) const noexcept {
+        return plane[wordOf(index)] >> (index % m_extents[0] % 64) & 1;
+    }
+
+    template<std::size_t Dimensions>
+    inline void NdBoard<Dimensions>::setBit(Plane& plane, const std::size_t index) const noexcept {
+        plane[wordOf(index)] |= std::uint64_t{1} << (index % m_extents[0] % 64);
+    }
+
+    template<std::size_t Dimensions>
+    inline void NdBoard<Dimensions>::flipBit(Plane& plane, const std::size_t index) const noexcept {
+        plane[wordOf(index)] ^= std::uint64_t{1} << (index % m_extents[0] % 64);
+    }
+
+    template<std::size_t Dimensions>
+    inline std::uint64_t NdBoard<Dimensions>::validBits(const std::size_t word) const noexcept {
+        const std::size_t remaining{m_extents[0] - word * 64};
+        return remaining >= 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << remaining) - 1;
+    }
+} // Minesweeper
+
+#endif //NDBOARD_HPP
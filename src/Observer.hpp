@@ -0,0 +1,129 @@
+#ifndef OBSERVER_HPP
+#define OBSERVER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Minesweeper {
+    // An observer watches a board's moves. Boards take one as a template parameter; every move that changes the
+    // board hands it one ChangeList with all the tiles the move changed, so a flood fill of thousands of tiles is a
+    // single call. An observer provides
+    //     static constexpr bool enabled{true};
+    //     void onChanges(const ChangeList& changes);
+    //     void onWin();
+    //     void onLoss(std::uint8_t row, std::uint8_t column);
+    // and a board built with NullObserver compiles all of the bookkeeping away.
+
+    enum class MoveKind : std::uint8_t {
+        reveal,
+        flag,
+        chord,
+        chordAll // the whole board at once, reported on tile (0, 0)
+    };
+
+    enum class ChangeKind : std::uint8_t {
+        revealed,
+        flagged,
+        unflagged
+    };
+
+    struct TileChange {
+        std::uint8_t row;
+        std::uint8_t column;
+        ChangeKind kind;
+    };
+
+    struct ChangeList {
+        MoveKind move;
+        std::uint8_t row; // the tile the move was made on
+        std::uint8_t column;
+        std::span<const TileChange> changes; // only valid for the duration of the call
+    };
+
+    struct NullObserver {
+        static constexpr bool enabled{false};
+    };
+
+    namespace detail {
+        // what a board with an enabled observer collects during a move
+        struct ChangeBuffer {
+            std::vector<TileChange> changes;
+            std::uint8_t lossRow{0};
+            std::uint8_t lossColumn{0};
+            bool reportedEnd{false};
+        };
+
+        struct NoChangeBuffer {
+        };
+    }
+
+    // keeps every change list it is given, for replays and for consumers that catch up between moves
+    class ChangeRecorder {
+    public:
+        struct Move {
+            MoveKind move;
+            std::uint8_t row;
+            std::uint8_t column;
+            std::size_t firstChange; // index into getChanges()
+            std::size_t changeAmount;
+        };
+
+        static constexpr bool enabled{true};
+
+        void onChanges(const ChangeList& changes);
+        void onWin() noexcept;
+        void onLoss(std::uint8_t row, std::uint8_t column) noexcept;
+        [[nodiscard]] const std::vector<Move>& getMoves() const noexcept;
+        [[nodiscard]] const std::vector<TileChange>& getChanges() const noexcept;
+        [[nodiscard]] bool isOver() const noexcept;
+        [[nodiscard]] bool isWon() const noexcept;
+        void clear() noexcept;
+
+    private:
+        std::vector<Move> m_moves;
+        std::vector<TileChange> m_changes;
+        bool m_over{false};
+        bool m_won{false};
+    };
+
+    inline void ChangeRecorder::onChanges(const ChangeList& changes) {
+        m_moves.push_back({changes.move, changes.row, changes.column, m_changes.size(), changes.changes.size()});
+        m_changes.insert(m_changes.end(), changes.changes.begin(), changes.changes.end());
+    }
+
+    inline void ChangeRecorder::onWin() noexcept {
+        m_over = true;
+        m_won = true;
+    }
+
+    inline void ChangeRecorder::onLoss(std::uint8_t, std::uint8_t) noexcept {
+        m_over = true;
+    }
+
+    inline const std::vector<ChangeRecorder::Move>& ChangeRecorder::getMoves() const noexcept {
+        return m_moves;
+    }
+
+    inline const std::vector<TileChange>& ChangeRecorder::getChanges() const noexcept {
+        return m_changes;
+    }
+
+    inline bool ChangeRecorder::isOver() const noexcept {
+        return m_over;
+    }
+
+    inline bool ChangeRecorder::isWon() const noexcept {
+        return m_won;
+    }
+
+    inline void ChangeRecorder::clear() noexcept {
+        m_moves.clear();
+        m_changes.clear();
+        m_over = false;
+        m_won = false;
+    }
+} // Minesweeper
+
+#endif //OBSERVER_HPP
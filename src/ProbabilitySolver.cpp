@@ -0,0 +1,877 @@
+#include "ProbabilitySolver.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <tuple>
+#include <utility>
+
+namespace Minesweeper {
+    namespace {
+        // the first and one past the last nonzero count; a component's mine counts only spread over a few values
+        [[nodiscard]] std::pair<std::size_t, std::size_t> support(const std::vector<double>& counts) noexcept {
+            std::size_t first{0};
+            std::size_t end{counts.size()};
+            while (first < end && counts[first] == 0.0) {
+                first++;
+            }
+            while (end > first && counts[end - 1] == 0.0) {
+                end--;
+            }
+            return {first, end};
+        }
+
+        void convolve(const std::vector<double>& a, const std::vector<double>& b, std::vector<double>& result) {
+            result.assign(a.size() + b.size() - 1, 0.0);
+            const auto [aFirst, aEnd]{support(a)};
+            const auto [bFirst, bEnd]{support(b)};
+            for (std::size_t i{aFirst}; i < aEnd; i++) {
+                for (std::size_t j{bFirst}; j < bEnd; j++) {
+                    result[i + j] += a[i] * b[j];
+                }
+            }
+        }
+    }
+
+    template<typename Topology>
+    BasicProbabilitySolver<Topology>::BasicProbabilitySolver(BS::thread_pool* const threadPool,
+                                                             std::shared_ptr<TranspositionTable> table):
+        m_threadPool{threadPool},
+        m_table{std::move(table)} {
+    }
+
+    // function(i) for i below amount, spread over the thread pool when there is one and more than one to do; the
+    // ones not started when a stop is requested are skipped
+    template<typename Topology>
+    template<typename Function>
+    void BasicProbabilitySolver<Topology>::forEachComponent(const std::size_t amount, Function&& function) {
+        if (m_threadPool == nullptr || amount < 2) {
+            for (std::size_t i{0}; i < amount && !m_cancel.stop_requested(); i++) {
+                function(i);
+            }
+            return;
+        }
+        m_threadPool->submit_sequence(std::size_t{0}, amount, [&](const std::size_t i) {
+            if (!m_cancel.stop_requested()) {
+                function(i);
+            }
+        }).wait();
+    }
+
+    template<typename Topology>
+    BasicProbabilitySolver<Topology>::Interruption::Interruption(
+        std::stop_token cancel, const std::optional<std::chrono::steady_clock::time_point> deadline):
+        m_cancel{std::move(cancel)},
+        m_deadline{deadline} {
+    }
+
+    template<typename Topology>
+    bool BasicProbabilitySolver<Topology>::Interruption::requested() noexcept {
+        if (!m_expired && m_deadline.has_value() && m_steps++ % clockStride == 0) {
+            m_expired = std::chrono::steady_clock::now() >= *m_deadline;
+        }
+        return m_expired || m_cancel.stop_requested();
+    }
+
+    template<typename Topology>
+    std::uint32_t BasicProbabilitySolver<Topology>::find(std::uint32_t tile) noexcept {
+        while (m_parents[tile] != tile) {
+            m_parents[tile] = m_parents[m_parents[tile]];
+            tile = m_parents[tile];
+        }
+        return tile;
+    }
+
+    // hidden and not settled by the solver
+    template<typename Topology>
+    bool BasicProbabilitySolver<Topology>::isHidden(const BasicSolver<Topology>& solver,
+                                                    const std::size_t index) noexcept {
+        return solver.viewAt(index) == BasicSolver<Topology>::hidden && !solver.isKnownSafe(index) &&
+               !solver.isKnownMine(index);
+    }
+
+    template<typename Topology>
+    bool BasicProbabilitySolver<Topology>::isNumber(const BasicSolver<Topology>& solver,
+                                                    const std::size_t index) noexcept {
+        return solver.viewAt(index) <= Topology::maxNeighbours;
+    }
+
+    // hidden and not settled by the solver or the parity elimination either
+    template<typename Topology>
+    bool BasicProbabilitySolver<Topology>::isOpen(const BasicSolver<Topology>& solver,
+                                                  const std::size_t index) const noexcept {
+        return isHidden(solver, index) && m_pins[index] == Pin::none;
+    }
+
+    template<typename Topology>
+    bool BasicProbabilitySolver<Topology>::isFrontier(const BasicSolver<Topology>& solver,
+                                                      const std::size_t index) const noexcept {
+        return isOpen(solver, index) && std::ranges::any_of(solver.neighboursOf(index), [&solver](const auto number) {
+            return isNumber(solver, number);
+        });
+    }
+
+    // keeps the counts of placed mines and open tiles and the probabilities of the tiles off the frontier in step;
+    // a pin lasts until the tile is revealed, flagged or settled by the solver
+    template<typename Topology>
+    void BasicProbabilitySolver<Topology>::refreshTile(const BasicSolver<Topology>& solver, const std::size_t index) {
+        if (!isHidden(solver, index)) {
+            m_pins[index] = Pin::none;
+        }
+        const TileState state{
+            solver.viewAt(index) == BasicSolver<Topology>::flagged || solver.isKnownMine(index) ||
+            m_pins[index] == Pin::mine ? TileState::placed
+            : isOpen(solver, index) ? TileState::open
+            : TileState::closed
+        };
+        m_placedAmount += (state == TileState::placed) - (m_states[index] == TileState::placed);
+        m_openAmount += (state == TileState::open) - (m_states[index] == TileState::open);
+        m_states[index] = state;
+        m_probabilities[index] = state == TileState::placed ? 1.0 : 0.0;
+    }
+
+    // Splits the seeds into components by the numbers they share and appends those: each is ordered breadth first
+    // through its numbers, its tiles gathered into groups and its numbers turned into masks over the positions.
+    // Every open tile a seed shares a number with has to be a seed as well, and the seeds come sorted, so that the
+    // order and with it the tallies of the table depend on nothing but the tiles and numbers a component hashes.
+    template<typename Topology>
+    void BasicProbabilitySolver<Topology>::buildComponents(const BasicSolver<Topology>& solver,
+                                                           const std::vector<std::uint16_t>& seeds) {
+        for (const std::uint16_t seed: seeds) {
+            m_parents[seed] = seed;
+        }
+        const std::uint32_t counted{nextEpoch()};
+        std::vector<std::uint16_t> numbers{};
+        for (const std::uint16_t seed: seeds) {
+            for (const std::uint16_t number: solver.neighboursOf(seed)) {
+                if (!isNumber(solver, number) || m_marks[number] == counted) {
+                    continue;
+                }
+                m_marks[number] = counted;
+                numbers.push_back(number);
+                const std::uint32_t first{find(seed)};
+                for (const std::uint16_t neighbour: solver.neighboursOf(number)) {
+                    if (isOpen(solver, neighbour)) {
+                        m_parents[find(neighbour)] = first;
+                    }
+                }
+            }
+        }
+        std::ranges::sort(numbers);
+
+        const std::size_t firstNew{m_components.size()};
+        const std::uint32_t rooted{nextEpoch()};
+        for (const std::uint16_t seed: seeds) {
+            const std::uint32_t root{find(seed)};
+            if (m_marks[root] != rooted) {
+                m_marks[root] = rooted;
+                m_rootComponents[root] = static_cast<std::int32_t>(m_components.size());
+                m_components.emplace_back();
+            }
+            m_componentOf[seed] = m_rootComponents[root];
+            Component& component{m_components[m_rootComponents[root]]};
+            component.tiles.push_back(seed);
+            component.hash ^= zobristKey(seed, 0);
+        }
+
+        struct Entry {
+            std::array<std::uint16_t, Topology::maxNeighbours> numbers;
+            std::uint16_t place;
+        };
+        const std::uint32_t visited{nextEpoch()};
+        std::vector<std::uint16_t> order{};
+        std::vector<Entry> entries{};
+        std::vector<std::pair<std::uint16_t, std::uint16_t>> runs{}; // a group's first place and its first entry
+        for (std::size_t i{firstNew}; i < m_components.size(); i++) {
+            Component& component{m_components[i]};
+            order.clear();
+            order.push_back(component.tiles.front());
+            m_marks[component.tiles.front()] = visited;
+            for (std::size_t next{0}; next < order.size(); next++) {
+                for (const std::uint16_t number: solver.neighboursOf(order[next])) {
+                    if (!isNumber(solver, number)) {
+                        continue;
+                    }
+                    for (const std::uint16_t tile: solver.neighboursOf(number)) {
+                        if (isOpen(solver, tile) && m_marks[tile] != visited) {
+                            m_marks[tile] = visited;
+                            order.push_back(tile);
+                        }
+                    }
+                }
+            }
+            // the tiles sorted by their numbers, so each group is a run, and the runs in order of their first tile
+            entries.clear();
+            for (std::size_t place{0}; place < order.size(); place++) {
+                Entry& entry{entries.emplace_back()};
+                entry.numbers.fill(0xFFFF);
+                entry.place = static_cast<std::uint16_t>(place);
+                std::size_t amount{0};
+                for (const std::uint16_t number: solver.neighboursOf(order[place])) {
+                    if (isNumber(solver, number)) {
+                        entry.numbers[amount++] = number;
+                    }
+                }
+                std::sort(entry.numbers.begin(), entry.numbers.begin() + static_cast<std::ptrdiff_t>(amount));
+            }
+            std::ranges::sort(entries, {}, [](const Entry& entry) {
+                return std::tie(entry.numbers, entry.place);
+            });
+            runs.clear();
+            for (std::size_t i{0}; i < entries.size(); i++) {
+                if (i == 0 || entries[i].numbers != entries[i - 1].numbers) {
+                    runs.push_back({entries[i].place, static_cast<std::uint16_t>(i)});
+                }
+            }
+            std::ranges::sort(runs);
+            component.tiles.clear();
+            for (std::size_t group{0}; group < runs.size(); group++) {
+                component.groupStarts.push_back(static_cast<std::uint16_t>(component.tiles.size()));
+                for (std::size_t i{runs[group].second};
+                     i < entries.size() && entries[i].numbers == entries[runs[group].second].numbers; i++) {
+                    const std::uint16_t tile{order[entries[i].place]};
+                    m_groupOf[tile] = static_cast<std::uint16_t>(group);
+                    m_positions[tile] = static_cast<std::uint16_t>(component.tiles.size());
+                    component.tiles.push_back(tile);
+                }
+            }
+            component.groupStarts.push_back(static_cast<std::uint16_t>(component.tiles.size()));
+            component.words = (component.tiles.size() + 63) / 64;
+            component.numbersAt.assign(runs.size(), {});
+        }
+
+        for (const std::uint16_t index: numbers) {
+            std::int32_t mines{solver.viewAt(index)};
+            Component* component{nullptr};
+            for (const std::uint16_t neighbour: solver.neighboursOf(index)) {
+                if (solver.viewAt(neighbour) == BasicSolver<Topology>::flagged || solver.isKnownMine(neighbour) ||
+                    m_pins[neighbour] == Pin::mine) {
+                    mines--;
+                } else if (isOpen(solver, neighbour)) {
+                    component = &m_components[m_componentOf[neighbour]];
+                }
+            }
+            if (component == nullptr) {
+                continue;
+            }
+            const std::size_t number{component->targets.size()};
+            component->targets.push_back(static_cast<std::uint8_t>(std::clamp(mines, 0, 0xFF)));
+            component->masks.resize(component->masks.size() + component->words, 0);
+            for (const std::uint16_t neighbour: solver.neighboursOf(index)) {
+                if (isOpen(solver, neighbour)) {
+                    const std::uint16_t position{m_positions[neighbour]};
+                    component->masks[number * component->words + position / 64] |= std::uint64_t{1} << position % 64;
+                    std::vector<std::uint16_t>& numbers{component->numbersAt[m_groupOf[neighbour]]};
+                    if (numbers.empty() || numbers.back() != number) {
+                        numbers.push_back(static_cast<std::uint16_t>(number));
+                    }
+                }
+            }
+            if (mines < 0) {
+                component->targets.back() = 0xFF; // more flags than the number allows, nothing can satisfy it
+            }
+            component->hash ^= zobristKey(index, std::min<std::size_t>(component->targets.back(), 9) + 1);
+        }
+
+        // the tiles the parity elimination settled leave their components, and what is left of those is split again
+        std::vector<std::uint16_t> rest{};
+        std::size_t kept{firstNew};
+        for (std::size_t i{firstNew}; i < m_components.size(); i++) {
+            if (reduce(m_components[i])) {
+                for (const std::uint16_t tile: m_components[i].tiles) {
+                    m_componentOf[tile] = -1;
+                    if (m_pins[tile] == Pin::none) {
+                        rest.push_back(tile);
+                    } else {
+                        refreshTile(solver, tile);
+                    }
+                }
+                continue;
+            }
+            if (kept != i) {
+                m_components[kept] = std::move(m_components[i]);
+                for (const std::uint16_t tile: m_components[kept].tiles) {
+                    m_componentOf[tile] = static_cast<std::int32_t>(kept);
+                }
+            }
+            kept++;
+        }
+        m_components.resize(kept);
+        if (!rest.empty()) {
+            std::ranges::sort(rest);
+            buildComponents(solver, rest);
+        }
+    }
+
+    // Eliminates the component's numbers modulo two, with one variable per group for the parity of the mines it
+    // takes, and keeps the reduced rows as parity checks for the enumeration, each run once its last group is
+    // assigned. A reduced row over a single group of one tile settles that tile outright, and the settled tiles get
+    // pinned for the caller to take them out of the component; returns whether there are any. A number left with
+    // only settled tiles that don't add up to it can't be met by any arrangement, which makes the component
+    // impossible instead.
+    template<typename Topology>
+    bool BasicProbabilitySolver<Topology>::reduce(Component& component) {
+        const std::size_t groups{component.groupStarts.size() - 1};
+        m_matrix.reset(groups);
+        for (const std::uint8_t target: component.targets) {
+            static_cast<void>(m_matrix.addRow(target % 2 == 1));
+        }
+        for (std::size_t group{0}; group < groups; group++) {
+            for (const std::uint16_t number: component.numbersAt[group]) {
+                m_matrix.set(number, group);
+            }
+        }
+        component.groupWords = groups / 64 + 1;
+        component.parityMasks.clear();
+        component.parities.clear();
+        component.paritiesAt.assign(groups, {});
+        component.impossible = !m_matrix.eliminate();
+        std::vector<std::uint64_t> settled(component.words, 0);
+        std::vector<std::uint64_t> settledMines(component.words, 0);
+        bool settling{false};
+        for (std::size_t row{0}; row < m_matrix.getRank(); row++) {
+            const std::size_t check{component.parities.size()};
+            component.parities.push_back(m_matrix.parity(row));
+            component.parityMasks.resize(component.parityMasks.size() + component.groupWords, 0);
+            std::size_t last{0};
+            m_matrix.forEachColumn(row, [&](const std::size_t group) {
+                component.parityMasks[check * component.groupWords + group / 64] |= std::uint64_t{1} << group % 64;
+                last = group;
+            });
+            component.paritiesAt[last].push_back(static_cast<std::uint16_t>(check));
+            if (m_matrix.weight(row) == 1 && component.groupStarts[last + 1] - component.groupStarts[last] == 1) {
+                const std::size_t position{component.groupStarts[last]};
+                settled[position / 64] |= std::uint64_t{1} << position % 64;
+                settledMines[position / 64] |= std::uint64_t{m_matrix.parity(row)} << position % 64;
+                settling = true;
+            }
+        }
+        if (!settling || component.impossible) {
+            return false;
+        }
+        for (std::size_t number{0}; number < component.targets.size(); number++) {
+            const std::uint64_t* mask{&component.masks[number * component.words]};
+            bool covered{true};
+            int mines{0};
+            for (std::size_t word{0}; word < component.words; word++) {
+                covered &= (mask[word] & ~settled[word]) == 0;
+                mines += std::popcount(mask[word] & settledMines[word]);
+            }
+            if (covered && mines != component.targets[number]) {
+                component.impossible = true;
+                return false;
+            }
+        }
+        for (std::size_t position{0}; position < component.tiles.size(); position++) {
+            if ((settled[position / 64] >> position % 64 & 1) == 0) {
+                continue;
+            }
+            const std::uint16_t tile{component.tiles[position]};
+            const bool mine{(settledMines[position / 64] >> position % 64 & 1) != 0};
+            m_pins[tile] = mine ? Pin::mine : Pin::safe;
+            (mine ? m_settledMines : m_settledSafe).push_back(tile);
+        }
+        return true;
+    }
+
+    template<typename Topology>
+    void BasicProbabilitySolver<Topology>::enumerate(Component& component, const std::size_t mineLimit,
+                                                     const std::stop_token& cancel) {
+        const std::size_t tiles{component.tiles.size()};
+        const std::size_t groups{component.groupStarts.size() - 1};
+        component.counted = true;
+        component.mineLimit = mineLimit;
+        component.arrangements.assign(tiles + 1, 0.0);
+        component.groupMines.assign(groups * (tiles + 1), 0.0);
+        std::vector<std::uint64_t> mines(component.words, 0);
+        std::vector<std::uint8_t> taken(groups, 0);
+        if (component.impossible) {
+            return;
+        }
+        Interruption interruption{cancel, std::nullopt};
+        descend(component, mines, taken, 0, 0, 1.0, mineLimit, interruption);
+    }
+
+    // Puts every possible amount of mines on the group's first tiles and goes on with each amount the numbers it
+    // touches still allow: a number is out once its mines pass its target, or the positions after the group can't
+    // make up the difference. ways counts the arrangements of the groups so far that look like this one. A list
+    // that has gone past its limit is of no use, so listing stops there.
+    template<typename Topology>
+    void BasicProbabilitySolver<Topology>::descend(Component& component, std::vector<std::uint64_t>& mines,
+                                                   std::vector<std::uint8_t>& taken, const std::size_t group,
+                                                   const std::size_t mineAmount, const double ways,
+                                                   const std::size_t mineLimit, Interruption& interruption) {
+        if (interruption.requested()
+            || (component.layoutLimit > 0 && component.layoutWays.size() > component.layoutLimit)) {
+            return;
+        }
+        const std::size_t tiles{component.tiles.size()};
+        if (group + 1 == component.groupStarts.size()) {
+            if (component.layoutLimit > 0) {
+                // one past the limit marks the list as cut short
+                component.layoutTakes.insert(component.layoutTakes.end(), taken.begin(), taken.end());
+                component.layoutWays.push_back(ways);
+                component.layoutMines.push_back(static_cast<std::uint16_t>(mineAmount));
+                return;
+            }
+            component.arrangements[mineAmount] += ways;
+            for (std::size_t g{0}; g < taken.size(); g++) {
+                component.groupMines[g * (tiles + 1) + mineAmount] += ways * taken[g];
+            }
+            return;
+        }
+
+        const std::size_t first{component.groupStarts[group]};
+        const std::size_t end{component.groupStarts[group + 1]};
+        const std::size_t endWord{end / 64};
+        const std::size_t most{std::min(end - first, mineLimit - mineAmount)};
+        double choices{1.0}; // C(end - first, mine)
+        for (std::size_t mine{0}; mine <= most; mine++) {
+            if (mine > 0) {
+                const std::size_t position{first + mine - 1};
+                mines[position / 64] |= std::uint64_t{1} << position % 64;
+                choices = choices * static_cast<double>(end - first - mine + 1) / static_cast<double>(mine);
+            }
+            bool feasible{true};
+            for (const std::uint16_t number: component.numbersAt[group]) {
+                const std::uint64_t* mask{&component.masks[number * component.words]};
+                int placed{0};
+                int undecided{0};
+                for (std::size_t word{0}; word < component.words; word++) {
+                    const std::uint64_t later{
+                        word < endWord ? 0 : word > endWord ? ~std::uint64_t{0} : ~(std::uint64_t{1} << end % 64) + 1
+                    };
+                    placed += std::popcount(mask[word] & mines[word]);
+                    undecided += std::popcount(mask[word] & later);
+                }
+                const int target{component.targets[number]};
+                if (placed > target || placed + undecided < target) {
+                    feasible = false;
+                    break;
+                }
+            }
+            taken[group] = static_cast<std::uint8_t>(mine);
+            for (const std::uint16_t check: component.paritiesAt[group]) {
+                if (!feasible) {
+                    break;
+                }
+                const std::uint64_t* mask{&component.parityMasks[check * component.groupWords]};
+                std::size_t parity{component.parities[check]};
+                for (std::size_t word{0}; word <= group / 64; word++) {
+                    for (std::uint64_t bits{mask[word]}; bits != 0; bits &= bits - 1) {
+                        parity += taken[word * 64 + std::countr_zero(bits)];
+                    }
+                }
+                feasible = parity % 2 == 0;
+            }
+            if (feasible) {
+                descend(component, mines, taken, group + 1, mineAmount + mine, ways * choices, mineLimit,
+                        interruption);
+            }
+        }
+        for (std::size_t position{first}; position < first + most; position++) {
+            mines[position / 64] &= ~(std::uint64_t{1} << position % 64);
+        }
+        taken[group] = 0;
+    }
+
+    // Fills in the probabilities from scratch and returns false if no arrangement of the mines fits what the solver
+    // has seen, which can only happen with wrong flags.
+    template<typename Topology>
+    bool BasicProbabilitySolver<Topology>::compute(const BasicSolver<Topology>& solver, const std::uint16_t mineCount,
+                                                   const std::stop_token cancel) {
+        m_cancel = cancel;
+        m_rowAmount = solver.getRowAmount();
+        m_columnAmount = solver.getColumnAmount();
+        m_zobristSalt = (std::uint64_t{m_rowAmount} << 8 | m_columnAmount) * 0xD1B54A32D192ED03;
+        m_settledSafe.clear();
+        m_settledMines.clear();
+        const std::size_t size{static_cast<std::size_t>(m_rowAmount) * m_columnAmount};
+        m_pins.assign(size, Pin::none);
+        std::vector<std::uint16_t> seeds{};
+        for (std::size_t index{0}; index < size; index++) {
+            if (isFrontier(solver, index)) {
+                seeds.push_back(static_cast<std::uint16_t>(index));
+            }
+        }
+        m_componentOf.assign(size, -1);
+        m_components.clear();
+        if (m_marks.size() != size) {
+            m_marks.assign(size, 0);
+            m_epoch = 0;
+            m_parents.resize(size);
+            m_rootComponents.resize(size);
+            m_positions.resize(size);
+            m_groupOf.resize(size);
+        }
+        while (m_logFactorials.size() <= size) {
+            m_logFactorials.push_back(std::lgamma(static_cast<double>(m_logFactorials.size()) + 1));
+        }
+        m_states.assign(size, TileState::closed);
+        m_probabilities.assign(size, 0.0);
+        m_placedAmount = 0;
+        m_openAmount = 0;
+        for (std::size_t index{0}; index < size; index++) {
+            refreshTile(solver, index);
+        }
+        buildComponents(solver, seeds);
+        m_dirty.clear();
+        m_safeSeen = solver.getSafeTiles().size();
+        m_mineSeen = solver.getMineTiles().size();
+        m_stale = false;
+        return combine(mineCount);
+    }
+
+    // the tiles the moves changed, for the next update()
+    template<typename Topology>
+    void BasicProbabilitySolver<Topology>::invalidate(const std::span<const TileChange> changes) {
+        for (const TileChange& change: changes) {
+            // a flag taken back brings tiles back into play that the solver had settled
+            m_stale |= change.kind == ChangeKind::unflagged;
+            m_dirty.push_back(static_cast<std::uint16_t>(change.row * m_columnAmount + change.column));
+        }
+    }
+
+    // The same as compute(), for a board that only changed by the moves passed to invalidate() since the last
+    // compute() or update(). Only the components a changed tile belonged to or a new number touches are rebuilt
+    // and enumerated again, the others keep their tallies. Tiles the solver settled in between count as changed.
+    template<typename Topology>
+    bool BasicProbabilitySolver<Topology>::update(const BasicSolver<Topology>& solver, const std::uint16_t mineCount,
+                                                  const std::stop_token cancel) {
+        m_cancel = cancel;
+        const std::span<const std::uint16_t> safeTiles{solver.getSafeTiles()};
+        const std::span<const std::uint16_t> mineTiles{solver.getMineTiles()};
+        if (m_stale || solver.getRowAmount() != m_rowAmount || solver.getColumnAmount() != m_columnAmount ||
+            safeTiles.size() < m_safeSeen || mineTiles.size() < m_mineSeen) {
+            return compute(solver, mineCount, cancel);
+        }
+        m_settledSafe.clear();
+        m_settledMines.clear();
+        m_dirty.insert(m_dirty.end(), safeTiles.begin() + static_cast<std::ptrdiff_t>(m_safeSeen), safeTiles.end());
+        m_dirty.insert(m_dirty.end(), mineTiles.begin() + static_cast<std::ptrdiff_t>(m_mineSeen), mineTiles.end());
+        m_safeSeen = safeTiles.size();
+        m_mineSeen = mineTiles.size();
+        for (const std::uint16_t changed: m_dirty) {
+            refreshTile(solver, changed);
+        }
+
+        // A changed tile was open in its component, if any, which goes. A number's open tiles all share its
+        // component, so the numbers next to the tile have nothing else to upset, except through a newly revealed
+        // number: that one ties its open neighbours together and puts the unconstrained ones on the frontier.
+        const std::uint32_t seeded{nextEpoch()};
+        std::vector<std::uint8_t> affected(m_components.size(), 0);
+        std::vector<std::uint16_t> seeds{};
+        const auto touch{[&](const std::uint16_t index) {
+            if (m_componentOf[index] >= 0) {
+                affected[m_componentOf[index]] = 1;
+            } else if (m_marks[index] != seeded && isOpen(solver, index)) {
+                m_marks[index] = seeded;
+                seeds.push_back(index);
+            }
+        }};
+        for (const std::uint16_t changed: m_dirty) {
+            if (m_componentOf[changed] >= 0) {
+                affected[m_componentOf[changed]] = 1;
+            }
+            if (isNumber(solver, changed)) {
+                for (const std::uint16_t neighbour: solver.neighboursOf(changed)) {
+                    touch(neighbour);
+                }
+            }
+        }
+        m_dirty.clear();
+
+        std::size_t kept{0};
+        for (std::size_t i{0}; i < m_components.size(); i++) {
+            if (affected[i] != 0) {
+                for (const std::uint16_t tile: m_components[i].tiles) {
+                    m_componentOf[tile] = -1;
+                    if (m_marks[tile] != seeded && isOpen(solver, tile)) {
+                        m_marks[tile] = seeded;
+                        seeds.push_back(tile);
+                    }
+                }
+                continue;
+            }
+            if (kept != i) {
+                m_components[kept] = std::move(m_components[i]);
+                for (const std::uint16_t tile: m_components[kept].tiles) {
+                    m_componentOf[tile] = static_cast<std::int32_t>(kept);
+                }
+            }
+            kept++;
+        }
+        m_components.resize(kept);
+        std::ranges::sort(seeds);
+        buildComponents(solver, seeds);
+        return combine(mineCount);
+    }
+
+    // enumerates the components that are new or counted with too few mines, unless the table has their tallies,
+    // then combines them all
+    template<typename Topology>
+    bool BasicProbabilitySolver<Topology>::combine(const std::uint16_t mineCount) {
+        m_unconstrainedProbability = 0.0;
+        if (m_placedAmount > mineCount) {
+            return false;
+        }
+        const std::size_t remaining{mineCount - m_placedAmount};
+        m_remaining = remaining;
+        std::size_t frontier{0};
+        for (const Component& component: m_components) {
+            frontier += component.tiles.size();
+        }
+        const std::size_t unconstrained{m_openAmount - frontier};
+
+        std::vector<std::size_t> uncounted{};
+        for (std::size_t i{0}; i < m_components.size(); i++) {
+            Component& component{m_components[i]};
+            if (component.counted && component.mineLimit >= remaining) {
+                continue;
+            }
+            if (m_table) {
+                const std::size_t tiles{component.tiles.size()};
+                component.arrangements.resize(tiles + 1);
+                component.groupMines.resize((component.groupStarts.size() - 1) * (tiles + 1));
+                m_stats.lookups++;
+                if (const std::optional<std::size_t> limit{
+                    m_table->load(component.hash, remaining, component.arrangements, component.groupMines)
+                }) {
+                    m_stats.hits++;
+                    component.counted = true;
+                    component.mineLimit = *limit >= tiles ? std::max(*limit, remaining) : *limit;
+                    continue;
+                }
+            }
+            uncounted.push_back(i);
+        }
+        forEachComponent(uncounted.size(), [&](const std::size_t i) {
+            enumerate(m_components[uncounted[i]], remaining, m_cancel);
+        });
+        if (m_cancel.stop_requested()) {
+            // some tallies are half done, and none of them may reach the table
+            m_stale = true;
+            return false;
+        }
+        m_stats.enumerated += uncounted.size();
+        if (m_table) {
+            for (const std::size_t i: uncounted) {
+                m_table->store(m_components[i].hash, remaining, m_components[i].arrangements,
+                               m_components[i].groupMines);
+            }
+        }
+
+        // prefixes[i] counts the arrangements of the components before i by mine count, suffixes[i] of i onwards;
+        // the buffers are kept between calls, update() runs this on every move
+        std::vector<std::vector<double>>& prefixes{m_prefixes};
+        std::vector<std::vector<double>>& suffixes{m_suffixes};
+        prefixes.resize(m_components.size() + 1);
+        suffixes.resize(m_components.size() + 1);
+        prefixes.front().assign(1, 1.0);
+        suffixes.back().assign(1, 1.0);
+        for (std::size_t i{0}; i < m_components.size(); i++) {
+            convolve(prefixes[i], m_components[i].arrangements, prefixes[i + 1]);
+        }
+        for (std::size_t i{m_components.size()}; i-- > 0;) {
+            convolve(m_components[i].arrangements, suffixes[i + 1], suffixes[i]);
+        }
+        const std::vector<double>& arrangements{prefixes.back()};
+
+        // the ways to place what the frontier leaves over on the unconstrained tiles, scaled by the largest
+        std::vector<double>& weights{m_weights};
+        weights.assign(arrangements.size(), 0.0);
+        double largest{-std::numeric_limits<double>::infinity()};
+        for (std::size_t mines{0}; mines < arrangements.size(); mines++) {
+            if (mines <= remaining && remaining - mines <= unconstrained && arrangements[mines] > 0.0) {
+                weights[mines] = m_logFactorials[unconstrained] - m_logFactorials[remaining - mines] -
+                                 m_logFactorials[unconstrained - remaining + mines];
+                largest = std::max(largest, weights[mines]);
+            }
+        }
+        double total{0.0};
+        double unconstrainedMines{0.0};
+        for (std::size_t mines{0}; mines < arrangements.size(); mines++) {
+            if (mines <= remaining && remaining - mines <= unconstrained && arrangements[mines] > 0.0) {
+                weights[mines] = std::exp(weights[mines] - largest);
+                total += arrangements[mines] * weights[mines];
+                unconstrainedMines += arrangements[mines] * weights[mines] * static_cast<double>(remaining - mines);
+            } else {
+                weights[mines] = 0.0;
+            }
+        }
+        if (total == 0.0) {
+            return false;
+        }
+
+        std::vector<double> others{};
+        std::vector<double> weightOf{}; // the weight of the rest of the board given the component's own mines
+        for (std::size_t i{0}; i < m_components.size(); i++) {
+            const Component& component{m_components[i]};
+            convolve(prefixes[i], suffixes[i + 1], others);
+            const std::size_t tiles{component.tiles.size()};
+            const auto [ownFirst, ownEnd]{support(component.arrangements)};
+            const auto [restFirst, restEnd]{support(others)};
+            weightOf.assign(tiles + 1, 0.0);
+            for (std::size_t own{ownFirst}; own < ownEnd; own++) {
+                for (std::size_t rest{restFirst}; rest < restEnd; rest++) {
+                    weightOf[own] += others[rest] * weights[own + rest];
+                }
+            }
+            for (std::size_t group{0}; group + 1 < component.groupStarts.size(); group++) {
+                double mines{0.0};
+                for (std::size_t own{ownFirst}; own < ownEnd; own++) {
+                    mines += component.groupMines[group * (tiles + 1) + own] * weightOf[own];
+                }
+                const std::size_t first{component.groupStarts[group]};
+                const std::size_t end{component.groupStarts[group + 1]};
+                for (std::size_t position{first}; position < end; position++) {
+                    m_probabilities[component.tiles[position]] = mines / total / static_cast<double>(end - first);
+                }
+            }
+        }
+        if (unconstrained > 0) {
+            m_unconstrainedProbability = unconstrainedMines / total / static_cast<double>(unconstrained);
+        }
+        return true;
+    }
+
+    // Lists the arrangements of the component with at most mineLimit mines, or as many as layoutLimit and one more
+    // if there are more, and orders them by mine count for sampleLayout(). A stop or the deadline leaves the list
+    // short. The tallies are left alone.
+    template<typename Topology>
+    void BasicProbabilitySolver<Topology>::listLayouts(Component& component, const std::size_t mineLimit,
+                                                       const std::size_t layoutLimit, const std::stop_token& cancel,
+                                                       const std::optional<std::chrono::steady_clock::time_point>
+                                                       deadline) {
+        const std::size_t tiles{component.tiles.size()};
+        const std::size_t groups{component.groupStarts.size() - 1};
+        component.layoutTakes.clear();
+        component.layoutWays.clear();
+        component.layoutMines.clear();
+        if (!component.impossible) {
+            std::vector<std::uint64_t> mines(component.words, 0);
+            std::vector<std::uint8_t> taken(groups, 0);
+            component.layoutLimit = layoutLimit;
+            Interruption interruption{cancel, deadline};
+            descend(component, mines, taken, 0, 0, 1.0, mineLimit, interruption);
+            component.layoutLimit = 0;
+        }
+
+        // a counting sort by mine count, the running totals starting over with each
+        const std::size_t amount{component.layoutWays.size()};
+        component.layoutStarts.assign(tiles + 2, 0);
+        for (const std::uint16_t mines: component.layoutMines) {
+            component.layoutStarts[mines + 1]++;
+        }
+        for (std::size_t mines{0}; mines <= tiles; mines++) {
+            component.layoutStarts[mines + 1] += component.layoutStarts[mines];
+        }
+        std::vector<std::uint32_t> next(component.layoutStarts.begin(), component.layoutStarts.end() - 1);
+        std::vector<std::uint8_t> takes(amount * groups);
+        std::vector<double> ways(amount);
+        for (std::size_t layout{0}; layout < amount; layout++) {
+            const std::size_t place{next[component.layoutMines[layout]]++};
+            std::copy_n(component.layoutTakes.begin() + static_cast<std::ptrdiff_t>(layout * groups), groups,
+                        takes.begin() + static_cast<std::ptrdiff_t>(place * groups));
+            ways[place] = component.layoutWays[layout];
+        }
+        for (std::size_t mines{0}; mines <= tiles; mines++) {
+            for (std::size_t place{component.layoutStarts[mines] + std::size_t{1}};
+                 place < component.layoutStarts[mines + 1]; place++) {
+                ways[place] += ways[place - 1];
+            }
+        }
+        component.layoutTakes = std::move(takes);
+        component.layoutWays = std::move(ways);
+    }
+
+    // Gets sampleLayout() ready for the probabilities last computed: every component's arrangements get listed, on
+    // the thread pool if there is one, and completions[i] weighs the ways to finish the board from component i on
+    // by the mines the components before it took, as far as the ratios between mine counts go. Returns false if a
+    // component has more than layoutLimit arrangements, nothing fits, or the deadline passes before all are listed.
+    template<typename Topology>
+    bool BasicProbabilitySolver<Topology>::prepareSampling(
+        const std::size_t layoutLimit, const std::optional<std::chrono::steady_clock::time_point> deadline) {
+        forEachComponent(m_components.size(), [&](const std::size_t i) {
+            listLayouts(m_components[i], m_remaining, layoutLimit, m_cancel, deadline);
+        });
+        if (m_cancel.stop_requested() || (deadline.has_value() && std::chrono::steady_clock::now() >= *deadline)) {
+            return false;
+        }
+        m_unconstrainedTiles.clear();
+        for (std::size_t index{0}; index < m_states.size(); index++) {
+            if (m_componentOf[index] < 0 && m_states[index] == TileState::open) {
+                m_unconstrainedTiles.push_back(static_cast<std::uint16_t>(index));
+            }
+        }
+
+        const std::size_t unconstrained{m_unconstrainedTiles.size()};
+        m_completions.resize(m_components.size() + 1);
+        std::vector<double>& last{m_completions.back()};
+        last.assign(m_remaining + 1, 0.0);
+        double largest{-std::numeric_limits<double>::infinity()};
+        for (std::size_t placed{0}; placed <= m_remaining; placed++) {
+            if (m_remaining - placed <= unconstrained) {
+                last[placed] = m_logFactorials[unconstrained] - m_logFactorials[m_remaining - placed] -
+                               m_logFactorials[unconstrained - m_remaining + placed];
+                largest = std::max(largest, last[placed]);
+            }
+        }
+        for (std::size_t placed{0}; placed <= m_remaining; placed++) {
+            last[placed] = m_remaining - placed <= unconstrained ? std::exp(last[placed] - largest) : 0.0;
+        }
+        for (std::size_t i{m_components.size()}; i-- > 0;) {
+            const Component& component{m_components[i]};
+            if (component.layoutWays.size() > layoutLimit) {
+                return false;
+            }
+            const std::vector<double>& rest{m_completions[i + 1]};
+            std::vector<double>& completions{m_completions[i]};
+            completions.assign(m_remaining + 1, 0.0);
+            double most{0.0};
+            for (std::size_t placed{0}; placed <= m_remaining; placed++) {
+                for (std::size_t k{0}; placed + k <= m_remaining && k + 1 < component.layoutStarts.size(); k++) {
+                    const std::uint32_t end{component.layoutStarts[k + 1]};
+                    if (end != component.layoutStarts[k]) {
+                        completions[placed] += component.layoutWays[end - 1] * rest[placed + k];
+                    }
+                }
+                most = std::max(most, completions[placed]);
+            }
+            if (most == 0.0) {
+                return false;
+            }
+            for (double& completion: completions) {
+                completion /= most;
+            }
+        }
+        return m_completions.front()[0] > 0.0;
+    }
+
+    // the hidden tile least likely to be a mine, known safe tiles first
+    template<typename Topology>
+    std::optional<TileCoordinates> BasicProbabilitySolver<Topology>::safestTile(
+        const BasicSolver<Topology>& solver) const noexcept {
+        std::optional<std::size_t> best{};
+        for (std::size_t index{0}; index < m_states.size(); index++) {
+            if (solver.viewAt(index) != BasicSolver<Topology>::hidden || solver.isKnownMine(index)) {
+                continue;
+            }
+            if (!best || probabilityOf(index) < probabilityOf(*best)) {
+                best = index;
+            }
+        }
+        if (!best) {
+            return std::nullopt;
+        }
+        return TileCoordinates{static_cast<std::uint8_t>(*best / m_columnAmount),
+                               static_cast<std::uint8_t>(*best % m_columnAmount)};
+    }
+
+    template class BasicProbabilitySolver<RectangularTopology>;
+    template class BasicProbabilitySolver<TorusTopology>;
+    template class BasicProbabilitySolver<HexagonalTopology>;
+    template class BasicProbabilitySolver<KnightTopology>;
+} // Minesweeper
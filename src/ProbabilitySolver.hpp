@@ -0,0 +1,316 @@
+#ifndef PROBABILITYSOLVER_HPP
+#define PROBABILITYSOLVER_HPP
+
+#include <algorithm>
+#include <BS_thread_pool.hpp> // https://github.com/bshoshany/thread-pool
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <random>
+#include <span>
+#include <stop_token>
+#include <vector>
+
+#include "ConstraintMatrix.hpp"
+#include "Observer.hpp"
+#include "RevealPolicy.hpp"
+#include "Solver.hpp"
+#include "TranspositionTable.hpp"
+
+
+namespace Minesweeper {
+    // Exact mine probabilities for the hidden tiles, given what a BasicSolver has seen and settled. The hidden tiles
+    // next to a revealed number (the frontier) split into components that share no number; each component's mine
+    // arrangements are enumerated on their own, spread over the caller's thread pool if it lends one, by backtracking
+    // in an order that finishes the numbers early and checking every number the last assigned group of tiles
+    // touches against bitmasks of the arrangement so far. A Gaussian elimination of the numbers modulo two (see
+    // ConstraintMatrix) runs first. Its reduced rows settle some tiles outright, which then leave the component
+    // as placed mines or safe tiles before it is split again, and the rest join the numbers as parity checks that
+    // cut branches short. The settled tiles are handed out, so a caller can play them as deductions.
+    // The arrangements are tallied by mine count, and the counts of all components are then combined and weighted
+    // by the ways of placing the remaining mines on the tiles no number sees, as binomials in log space. Between
+    // moves, update() only rebuilds the components a move's change list can reach and keeps the tallies of the rest.
+    // Each component is hashed Zobrist style from its tiles and its numbers' targets as it is built, and with a
+    // TranspositionTable, which may be shared with other solvers of the same topology, a component whose tallies
+    // are already in the table is not enumerated again. For a caller that wants whole boards rather than odds,
+    // prepareSampling() lists every component's arrangements once, and sampleLayout() then draws layouts of the
+    // hidden mines that fit the numbers, each with its true probability, from any number of threads at once.
+    // compute() and update() take a stop token; once a stop is requested the enumeration returns where it is, the
+    // result is meaningless and the next update() starts from scratch. prepareSampling() also gives up at a
+    // deadline, if it is given one.
+    template<typename Topology>
+    class BasicProbabilitySolver final {
+    public:
+        struct Stats {
+            std::uint64_t enumerated{0}; // components counted by enumeration
+            std::uint64_t lookups{0}; // components looked up in the table
+            std::uint64_t hits{0};
+            std::size_t tableBytes{0};
+        };
+
+    private:
+        // The tiles of a component in enumeration order and its numbers as bitmasks over those positions. Tiles
+        // next to the same numbers form a group and sit next to each other; a group takes j mines in C(size, j)
+        // ways without the enumeration telling them apart. The tallies are by mine count, groupMines holds a row
+        // of them per group with the mines the group took.
+        struct Component {
+            std::vector<std::uint16_t> tiles;
+            std::vector<std::uint16_t> groupStarts; // and one past the last group
+            std::vector<std::uint64_t> masks;
+            std::vector<std::uint8_t> targets;
+            std::vector<std::vector<std::uint16_t>> numbersAt; // the numbers each group takes part in
+            std::vector<std::uint64_t> parityMasks; // the reduced parity rows over the groups
+            std::vector<std::uint8_t> parities;
+            std::vector<std::vector<std::uint16_t>> paritiesAt; // the parity rows each group is the last one of
+            std::size_t words{0};
+            std::size_t groupWords{0};
+            std::uint64_t hash{0}; // of the open tiles and the numbers' targets
+            bool impossible{false};
+            bool counted{false};
+            std::size_t mineLimit{0}; // the most mines the tallies go up to
+            std::vector<double> arrangements;
+            std::vector<double> groupMines;
+            // the arrangements themselves as the mines each group took, for sampling: listed while layoutLimit is
+            // set, then ordered by mine count, layoutStarts the first of each count and layoutWays running totals
+            // that start over with each count
+            std::size_t layoutLimit{0};
+            std::vector<std::uint8_t> layoutTakes;
+            std::vector<double> layoutWays;
+            std::vector<std::uint16_t> layoutMines;
+            std::vector<std::uint32_t> layoutStarts;
+        };
+
+        enum class TileState : std::uint8_t {open, placed, closed};
+        enum class Pin : std::uint8_t {none, safe, mine}; // what the parity elimination settled a tile as
+
+        BS::thread_pool* m_threadPool; // not owned, and without one the components are worked through in turn
+        std::shared_ptr<TranspositionTable> m_table;
+        std::uint64_t m_zobristSalt{0}; // tells boards of different sizes apart
+        Stats m_stats{};
+        ConstraintMatrix m_matrix;
+        std::vector<Component> m_components;
+        std::vector<double> m_probabilities; // of the frontier, settled and revealed tiles
+        std::vector<TileState> m_states;
+        std::vector<Pin> m_pins;
+        std::vector<std::uint16_t> m_settledSafe; // the tiles pinned by the last compute() or update()
+        std::vector<std::uint16_t> m_settledMines;
+        double m_unconstrainedProbability{0.0};
+        std::size_t m_placedAmount{0};
+        std::size_t m_openAmount{0};
+        std::vector<double> m_logFactorials; // log n! up to the size of the board
+        std::vector<std::vector<double>> m_prefixes;
+        std::vector<std::vector<double>> m_suffixes;
+        std::vector<double> m_weights;
+        std::vector<std::uint32_t> m_parents;
+        std::vector<std::int32_t> m_rootComponents;
+        std::vector<std::int32_t> m_componentOf;
+        std::vector<std::uint16_t> m_positions; // a frontier tile's position and group in its component
+        std::vector<std::uint16_t> m_groupOf;
+        std::vector<std::uint32_t> m_marks; // tiles seen in the current pass carry its epoch
+        std::uint32_t m_epoch{0};
+        std::vector<std::uint16_t> m_dirty; // the tiles changed since the components were last brought up to date
+        std::size_t m_safeSeen{0}; // how many of the solver's settled tiles that accounts for
+        std::size_t m_mineSeen{0};
+        bool m_stale{true};
+        std::uint8_t m_rowAmount{0};
+        std::uint8_t m_columnAmount{0};
+        std::size_t m_remaining{0}; // the mines left for the open tiles
+        std::vector<std::vector<double>> m_completions; // see prepareSampling()
+        std::vector<std::uint16_t> m_unconstrainedTiles;
+        std::stop_token m_cancel{}; // of the last compute() or update()
+
+        // Whether an enumeration should return where it is: a stop was requested, or the deadline has passed. The
+        // clock is only read every so many steps, so every thread enumerating needs one of its own.
+        class Interruption {
+            static constexpr std::uint32_t clockStride{128};
+
+            std::stop_token m_cancel;
+            std::optional<std::chrono::steady_clock::time_point> m_deadline;
+            std::uint32_t m_steps{0};
+            bool m_expired{false};
+
+        public:
+            Interruption(std::stop_token cancel, std::optional<std::chrono::steady_clock::time_point> deadline);
+            [[nodiscard]] bool requested() noexcept;
+        };
+
+        [[nodiscard]] static bool isHidden(const BasicSolver<Topology>& solver, std::size_t index) noexcept;
+        [[nodiscard]] static bool isNumber(const BasicSolver<Topology>& solver, std::size_t index) noexcept;
+        [[nodiscard]] bool isOpen(const BasicSolver<Topology>& solver, std::size_t index) const noexcept;
+        [[nodiscard]] bool isFrontier(const BasicSolver<Topology>& solver, std::size_t index) const noexcept;
+        [[nodiscard]] std::uint32_t find(std::uint32_t tile) noexcept;
+        [[nodiscard]] std::uint32_t nextEpoch() noexcept;
+        [[nodiscard]] std::uint64_t zobristKey(std::size_t index, std::size_t state) const noexcept;
+        [[nodiscard]] double probabilityOf(std::size_t index) const noexcept;
+        void refreshTile(const BasicSolver<Topology>& solver, std::size_t index);
+        void buildComponents(const BasicSolver<Topology>& solver, const std::vector<std::uint16_t>& seeds);
+        [[nodiscard]] bool reduce(Component& component);
+        static void enumerate(Component& component, std::size_t mineLimit, const std::stop_token& cancel);
+        static void listLayouts(Component& component, std::size_t mineLimit, std::size_t layoutLimit,
+                                const std::stop_token& cancel,
+                                std::optional<std::chrono::steady_clock::time_point> deadline);
+        static void descend(Component& component, std::vector<std::uint64_t>& mines, std::vector<std::uint8_t>& taken,
+                            std::size_t group, std::size_t mineAmount, double ways, std::size_t mineLimit,
+                            Interruption& interruption);
+        [[nodiscard]] bool combine(std::uint16_t mineCount);
+        template<typename Function>
+        void forEachComponent(std::size_t amount, Function&& function);
+
+    public:
+        static constexpr std::size_t defaultLayoutLimit{std::size_t{1} << 16};
+
+        explicit BasicProbabilitySolver(BS::thread_pool* threadPool = nullptr,
+                                        std::shared_ptr<TranspositionTable> table = {});
+        [[nodiscard]] bool compute(const BasicSolver<Topology>& solver, std::uint16_t mineCount,
+                                   std::stop_token cancel = {});
+        void invalidate(std::span<const TileChange> changes);
+        [[nodiscard]] bool update(const BasicSolver<Topology>& solver, std::uint16_t mineCount,
+                                  std::stop_token cancel = {});
+        [[nodiscard]] double probabilityAt(std::uint8_t row, std::uint8_t column) const noexcept;
+        [[nodiscard]] std::optional<TileCoordinates> safestTile(const BasicSolver<Topology>& solver) const noexcept;
+        [[nodiscard]] std::size_t getComponentAmount() const noexcept;
+        [[nodiscard]] std::size_t getForcedAmount() const noexcept;
+        [[nodiscard]] std::span<const std::uint16_t> getSettledSafeTiles() const noexcept;
+        [[nodiscard]] std::span<const std::uint16_t> getSettledMineTiles() const noexcept;
+        [[nodiscard]] Stats getStats() const noexcept;
+        [[nodiscard]] bool prepareSampling(std::size_t layoutLimit = defaultLayoutLimit,
+                                           std::optional<std::chrono::steady_clock::time_point> deadline = {});
+        template<typename Generator>
+        void sampleLayout(Generator& generator, std::vector<std::uint8_t>& mines) const;
+    };
+
+    using ProbabilitySolver = BasicProbabilitySolver<RectangularTopology>;
+
+    template<typename Topology>
+    inline std::uint32_t BasicProbabilitySolver<Topology>::nextEpoch() noexcept {
+        if (++m_epoch == 0) {
+            std::ranges::fill(m_marks, 0);
+            m_epoch = 1;
+        }
+        return m_epoch;
+    }
+
+    // the key of a tile in a state: 0 for open, 1 + its target for a number, 10 for a number flags overfill
+    template<typename Topology>
+    inline std::uint64_t BasicProbabilitySolver<Topology>::zobristKey(const std::size_t index,
+                                                                      const std::size_t state) const noexcept {
+        // SplitMix64 of the slot, so every solver draws the same keys without a table of them
+        std::uint64_t key{m_zobristSalt + (index * 11 + state + 1) * 0x9E3779B97F4A7C15};
+        key = (key ^ key >> 30) * 0xBF58476D1CE4E5B9;
+        key = (key ^ key >> 27) * 0x94D049BB133111EB;
+        return key ^ key >> 31;
+    }
+
+    template<typename Topology>
+    inline double BasicProbabilitySolver<Topology>::probabilityAt(const std::uint8_t row,
+                                                                  const std::uint8_t column) const noexcept {
+        return probabilityOf(row * m_columnAmount + column);
+    }
+
+    // the open tiles no number sees all share one probability instead of each being written on every update
+    template<typename Topology>
+    inline double BasicProbabilitySolver<Topology>::probabilityOf(const std::size_t index) const noexcept {
+        return m_componentOf[index] < 0 && m_states[index] == TileState::open ? m_unconstrainedProbability
+                                                                               : m_probabilities[index];
+    }
+
+    template<typename Topology>
+    inline std::size_t BasicProbabilitySolver<Topology>::getComponentAmount() const noexcept {
+        return m_components.size();
+    }
+
+    // the tiles the parity elimination settled in the components the last compute() or update() rebuilt
+    template<typename Topology>
+    inline std::size_t BasicProbabilitySolver<Topology>::getForcedAmount() const noexcept {
+        return m_settledSafe.size() + m_settledMines.size();
+    }
+
+    // the same tiles by what they were settled as; the solver has not seen them, and they stay settled here until
+    // it has or they are revealed
+    template<typename Topology>
+    inline std::span<const std::uint16_t> BasicProbabilitySolver<Topology>::getSettledSafeTiles() const noexcept {
+        return m_settledSafe;
+    }
+
+    template<typename Topology>
+    inline std::span<const std::uint16_t> BasicProbabilitySolver<Topology>::getSettledMineTiles() const noexcept {
+        return m_settledMines;
+    }
+
+    // totals since the solver was made; the table's memory counts in full even while it is shared
+    template<typename Topology>
+    inline typename BasicProbabilitySolver<Topology>::Stats
+    BasicProbabilitySolver<Topology>::getStats() const noexcept {
+        Stats stats{m_stats};
+        stats.tableBytes = m_table ? m_table->memoryUsage() : 0;
+        return stats;
+    }
+
+    // Fills mines with a layout, one per tile, drawn from those that fit the last compute() or update() after a
+    // prepareSampling(). Each component's mine count is drawn by how many ways it and everything after it can take
+    // it, then one of its arrangements with that count, then the tiles of each group that hold its mines, and the
+    // rest of the mines go on the unconstrained tiles, so every layout comes up as often as it would in the game.
+    template<typename Topology>
+    template<typename Generator>
+    void BasicProbabilitySolver<Topology>::sampleLayout(Generator& generator, std::vector<std::uint8_t>& mines) const {
+        std::uniform_real_distribution<double> uniform{};
+        // k of the tiles, every choice as likely, in a single pass
+        const auto choose{[&](const std::span<const std::uint16_t> tiles, std::size_t k) {
+            for (std::size_t i{0}; i < tiles.size() && k > 0; i++) {
+                if (uniform(generator) * static_cast<double>(tiles.size() - i) < static_cast<double>(k)) {
+                    mines[tiles[i]] = 1;
+                    k--;
+                }
+            }
+        }};
+        mines.assign(m_states.size(), 0);
+        for (std::size_t index{0}; index < m_states.size(); index++) {
+            mines[index] = m_states[index] == TileState::placed;
+        }
+        std::size_t placed{0};
+        for (std::size_t i{0}; i < m_components.size(); i++) {
+            const Component& component{m_components[i]};
+            const std::vector<double>& rest{m_completions[i + 1]};
+            // the weight of the component taking k mines and the rest of the board the others
+            const auto waysWith{[&](const std::size_t k) {
+                const std::uint32_t end{component.layoutStarts[k + 1]};
+                return end == component.layoutStarts[k] || placed + k >= rest.size()
+                           ? 0.0
+                           : component.layoutWays[end - 1] * rest[placed + k];
+            }};
+            double total{0.0};
+            for (std::size_t k{0}; k + 1 < component.layoutStarts.size(); k++) {
+                total += waysWith(k);
+            }
+            double pick{uniform(generator) * total};
+            std::size_t k{0};
+            for (std::size_t amount{0}; amount + 1 < component.layoutStarts.size(); amount++) {
+                const double ways{waysWith(amount)};
+                if (ways > 0.0) {
+                    k = amount;
+                    if (pick < ways) {
+                        break;
+                    }
+                    pick -= ways;
+                }
+            }
+            const auto first{component.layoutWays.begin() + component.layoutStarts[k]};
+            const auto end{component.layoutWays.begin() + component.layoutStarts[k + 1]};
+            const auto layout{std::min(std::upper_bound(first, end, uniform(generator) * end[-1]), end - 1)};
+            const std::size_t index{static_cast<std::size_t>(layout - component.layoutWays.begin())};
+            const std::size_t groups{component.groupStarts.size() - 1};
+            const std::span<const std::uint16_t> tiles{component.tiles};
+            for (std::size_t group{0}; group < groups; group++) {
+                choose(tiles.subspan(component.groupStarts[group],
+                                     component.groupStarts[group + 1] - component.groupStarts[group]),
+                       component.layoutTakes[index * groups + group]);
+            }
+            placed += k;
+        }
+        choose(m_unconstrainedTiles, m_remaining - placed);
+    }
+} // Minesweeper
+
+#endif //PROBABILITYSOLVER_HPP
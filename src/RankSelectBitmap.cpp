@@ -0,0 +1,149 @@
+#include "RankSelectBitmap.hpp"
+
+#include <bit>
+#include <cassert>
+
+namespace Minesweeper {
+    namespace {
+        std::size_t selectInWord(std::uint64_t word, std::size_t k) noexcept {
+            for (; k > 0; k--) {
+                word &= word - 1;
+            }
+            return static_cast<std::size_t>(std::countr_zero(word));
+        }
+    }
+
+    RankSelectBitmap::RankSelectBitmap(const std::size_t size, const bool value): m_words((size + 63) / 64, 0),
+        m_superblockRanks((m_words.size() + wordsPerSuperblock - 1) / wordsPerSuperblock + 1, 0),
+        m_wordRanks(m_words.size(), 0),
+        m_size{size} {
+        if (value) {
+            std::ranges::fill(m_words, ~std::uint64_t{0});
+            if (size % 64 != 0) {
+                m_words.back() = (std::uint64_t{1} << size % 64) - 1;
+            }
+            m_ones = size;
+        }
+    }
+
+    std::size_t RankSelectBitmap::rank(const std::size_t position) const {
+        assert(position <= m_size);
+        refreshIndex();
+        const std::size_t word{position / 64};
+        if (word == m_words.size()) {
+            return m_ones;
+        }
+        const std::uint64_t below{(std::uint64_t{1} << (position % 64)) - 1};
+        return m_superblockRanks[word / wordsPerSuperblock] + m_wordRanks[word]
+               + static_cast<std::size_t>(std::popcount(m_words[word] & below));
+    }
+
+    std::size_t RankSelectBitmap::select(const std::size_t k) const {
+        assert(k < m_ones);
+        return selectImpl<true>(k);
+    }
+
+    std::size_t RankSelectBitmap::select0(const std::size_t k) const {
+        assert(k < m_size - m_ones);
+        return selectImpl<false>(k);
+    }
+
+    std::size_t RankSelectBitmap::superblockRank(const std::size_t superblock, const bool ones) const noexcept {
+        return ones ? m_superblockRanks[superblock]
+                    : superblock * wordsPerSuperblock * 64 - m_superblockRanks[superblock];
+    }
+
+    template<bool Ones>
+    std::size_t RankSelectBitmap::selectImpl(std::size_t k) const {
+        refreshIndex();
+        const SelectIndex& index{Ones ? m_oneIndex : m_zeroIndex};
+        const std::size_t block{k / sampleRate};
+        if (index.positionStarts[block + 1] != index.positionStarts[block]) {
+            return index.positions[index.positionStarts[block] + k % sampleRate];
+        }
+        // the k-th lies between this block's sample and the next one, at most sparseSpan superblocks apart
+        std::size_t low{index.samples[block]};
+        std::size_t high{block + 1 < index.samples.size() ? index.samples[block + 1] : m_superblockRanks.size() - 2};
+        while (low < high) {
+            const std::size_t middle{(low + high + 1) / 2};
+            if (superblockRank(middle, Ones) <= k) {
+                low = middle;
+            } else {
+                high = middle - 1;
+            }
+        }
+        k -= superblockRank(low, Ones);
+        for (std::size_t word{low * wordsPerSuperblock};; word++) {
+            const std::uint64_t bits{Ones ? m_words[word] : ~m_words[word]};
+            const auto amount{static_cast<std::size_t>(std::popcount(bits))};
+            if (k < amount) {
+                return word * 64 + selectInWord(bits, k);
+            }
+            k -= amount;
+        }
+    }
+
+    void RankSelectBitmap::refreshIndex() const {
+        const std::size_t superblockAmount{m_superblockRanks.size() - 1};
+        if (m_dirtyFrom > superblockAmount) {
+            return;
+        }
+        std::size_t running{m_superblockRanks[std::min(m_dirtyFrom, superblockAmount)]};
+        for (std::size_t superblock{m_dirtyFrom}; superblock < superblockAmount; superblock++) {
+            m_superblockRanks[superblock] = static_cast<std::uint32_t>(running);
+            const std::size_t end{std::min(m_words.size(), (superblock + 1) * wordsPerSuperblock)};
+            for (std::size_t word{superblock * wordsPerSuperblock}; word < end; word++) {
+                m_wordRanks[word] = static_cast<std::uint16_t>(running - m_superblockRanks[superblock]);
+                running += static_cast<std::size_t>(std::popcount(m_words[word]));
+            }
+        }
+        m_superblockRanks[superblockAmount] = static_cast<std::uint32_t>(running);
+        refreshSelectIndex<true>(m_oneIndex, m_ones, m_dirtyFrom);
+        refreshSelectIndex<false>(m_zeroIndex, m_size - m_ones, m_dirtyFrom);
+        m_dirtyFrom = superblockAmount + 1;
+    }
+
+    template<bool Ones>
+    void RankSelectBitmap::refreshSelectIndex(SelectIndex& index, const std::size_t total,
+                                              const std::size_t dirtyFrom) const {
+        const std::size_t superblockAmount{m_superblockRanks.size() - 1};
+        const std::size_t blockAmount{total / sampleRate + 1};
+        // samples falling before the first changed superblock still hold, but the last of them may now end its
+        // block elsewhere, so the blocks are redone from that one on
+        const std::size_t kept{(superblockRank(std::min(dirtyFrom, superblockAmount), Ones) + sampleRate - 1)
+                               / sampleRate};
+        const std::size_t first{kept == 0 ? 0 : kept - 1};
+        index.samples.resize(blockAmount);
+        index.positionStarts.resize(blockAmount + 1);
+        std::size_t superblock{kept == 0 ? 0 : index.samples[first]};
+        for (std::size_t block{first}; block < blockAmount; block++) {
+            while (superblock + 1 < superblockAmount && superblockRank(superblock + 1, Ones) <= block * sampleRate) {
+                superblock++;
+            }
+            index.samples[block] = static_cast<std::uint32_t>(superblock);
+        }
+        index.positions.resize(index.positionStarts[first]);
+        for (std::size_t block{first}; block < blockAmount; block++) {
+            index.positionStarts[block] = static_cast<std::uint32_t>(index.positions.size());
+            const std::size_t start{index.samples[block]};
+            const std::size_t end{block + 1 < blockAmount ? index.samples[block + 1] : superblockAmount};
+            if (end - start <= sparseSpan) {
+                continue;
+            }
+            std::size_t skipped{block * sampleRate - superblockRank(start, Ones)};
+            std::size_t wanted{std::min(total - block * sampleRate, sampleRate)};
+            for (std::size_t word{start * wordsPerSuperblock}; wanted > 0; word++) {
+                for (std::uint64_t bits{Ones ? m_words[word] : ~m_words[word]}; bits != 0 && wanted > 0;
+                     bits &= bits - 1) {
+                    if (skipped > 0) {
+                        skipped--;
+                        continue;
+                    }
+                    index.positions.push_back(static_cast<std::uint32_t>(word * 64 + std::countr_zero(bits)));
+                    wanted--;
+                }
+            }
+        }
+        index.positionStarts[blockAmount] = static_cast<std::uint32_t>(index.positions.size());
+    }
+} // Minesweeper
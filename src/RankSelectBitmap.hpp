@@ -0,0 +1,110 @@
+#ifndef RANKSELECTBITMAP_HPP
+#define RANKSELECTBITMAP_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace Minesweeper {
+    // A bitmap with a popcount index: absolute ranks per 512-bit superblock, ranks relative to the superblock per
+    // word, and the superblock of every 512th one and zero. rank() is then two lookups and a popcount. select()
+    // binary searches the superblocks between two samples and then scans at most the 8 words of one superblock; the
+    // 512 ones or zeros after a sample that spread over more than 128 superblocks have their positions stored
+    // outright instead, which costs at most a quarter of the bits they cover. Updates only touch the words; the
+    // index is rebuilt from the first changed superblock onwards the next time it is queried.
+    class RankSelectBitmap final {
+        static constexpr std::size_t wordsPerSuperblock{8};
+        static constexpr std::size_t sampleRate{512};
+        static constexpr std::size_t sparseSpan{128}; // superblocks a block of samples may cover before it is listed
+
+        struct SelectIndex {
+            std::vector<std::uint32_t> samples; // the superblock holding every sampleRate-th one or zero
+            std::vector<std::uint32_t> positionStarts; // where each block's listed positions start, and one past
+            std::vector<std::uint32_t> positions; // every position in the blocks covering too many superblocks
+        };
+
+        std::vector<std::uint64_t> m_words;
+        mutable std::vector<std::uint32_t> m_superblockRanks;
+        mutable std::vector<std::uint16_t> m_wordRanks;
+        mutable SelectIndex m_oneIndex;
+        mutable SelectIndex m_zeroIndex;
+        mutable std::size_t m_dirtyFrom{0};
+        std::size_t m_size;
+        std::size_t m_ones{0};
+
+        void refreshIndex() const;
+        template<bool Ones>
+        void refreshSelectIndex(SelectIndex& index, std::size_t total, std::size_t dirtyFrom) const;
+        template<bool Ones>
+        [[nodiscard]] std::size_t selectImpl(std::size_t k) const;
+        [[nodiscard]] std::size_t superblockRank(std::size_t superblock, bool ones) const noexcept;
+
+    public:
+        explicit RankSelectBitmap(std::size_t size = 0, bool value = false);
+        [[nodiscard]] std::size_t size() const noexcept;
+        [[nodiscard]] std::size_t count() const noexcept;
+        [[nodiscard]] bool test(std::size_t position) const noexcept;
+        [[nodiscard]] std::uint64_t bitsAt(std::size_t position) const noexcept;
+        void set(std::size_t position) noexcept;
+        void reset(std::size_t position) noexcept;
+        void clear() noexcept;
+        [[nodiscard]] std::size_t rank(std::size_t position) const;
+        [[nodiscard]] std::size_t rank0(std::size_t position) const;
+        [[nodiscard]] std::size_t select(std::size_t k) const;
+        [[nodiscard]] std::size_t select0(std::size_t k) const;
+    };
+
+    inline std::size_t RankSelectBitmap::size() const noexcept {
+        return m_size;
+    }
+
+    inline std::size_t RankSelectBitmap::count() const noexcept {
+        return m_ones;
+    }
+
+    inline bool RankSelectBitmap::test(const std::size_t position) const noexcept {
+        return m_words[position / 64] >> (position % 64) & 1;
+    }
+
+    // the 64 bits from position on as one word, lowest first and zero past the end
+    inline std::uint64_t RankSelectBitmap::bitsAt(const std::size_t position) const noexcept {
+        const std::size_t word{position / 64};
+        const std::size_t shift{position % 64};
+        const std::uint64_t low{m_words[word] >> shift};
+        return shift == 0 || word + 1 == m_words.size() ? low : low | m_words[word + 1] << (64 - shift);
+    }
+
+    inline void RankSelectBitmap::set(const std::size_t position) noexcept {
+        std::uint64_t& word{m_words[position / 64]};
+        const std::uint64_t mask{std::uint64_t{1} << (position % 64)};
+        if ((word & mask) == 0) {
+            word |= mask;
+            m_ones++;
+            m_dirtyFrom = std::min(m_dirtyFrom, position / 64 / wordsPerSuperblock);
+        }
+    }
+
+    inline void RankSelectBitmap::reset(const std::size_t position) noexcept {
+        std::uint64_t& word{m_words[position / 64]};
+        const std::uint64_t mask{std::uint64_t{1} << (position % 64)};
+        if ((word & mask) != 0) {
+            word &= ~mask;
+            m_ones--;
+            m_dirtyFrom = std::min(m_dirtyFrom, position / 64 / wordsPerSuperblock);
+        }
+    }
+
+    inline void RankSelectBitmap::clear() noexcept {
+        std::ranges::fill(m_words, 0);
+        m_ones = 0;
+        m_dirtyFrom = 0;
+    }
+
+    inline std::size_t RankSelectBitmap::rank0(const std::size_t position) const {
+        return position - rank(position);
+    }
+} // Minesweeper
+
+#endif //RANKSELECTBITMAP_HPP
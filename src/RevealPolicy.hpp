@@ -0,0 +1,122 @@
+#ifndef REVEALPOLICY_HPP
+#define REVEALPOLICY_HPP
+
+#include <BS_thread_pool.hpp> // https://github.com/bshoshany/thread-pool
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace Minesweeper {
+    // A reveal policy decides how the tiles of a zero region get opened once a reveal reaches them. Boards take
+    // one as a template parameter and befriend it; open() is handed the first tiles to open, calls the board's
+    // openTile on each and follows the neighbours of every zero it opens. synchronised() guards the board's shared
+    // bitmaps while the policy is running.
+
+    using TileCoordinates = std::pair<std::uint8_t, std::uint8_t>;
+
+    // opens tiles as tasks on a thread pool with a lock per tile, so large openings spread over every core
+    class ParallelReveal final {
+        BS::thread_pool m_threadPool{BS::thread_pool()};
+        std::deque<std::mutex> m_tileLocks;
+        std::mutex m_sharedMutex{};
+
+        template<typename Board>
+        void openFrom(Board& board, std::uint8_t row, std::uint8_t column);
+
+    public:
+        explicit ParallelReveal(std::size_t storageSize);
+        template<typename Board>
+        void open(Board& board, std::span<const TileCoordinates> tiles);
+        template<typename Function>
+        void synchronised(Function&& function);
+    };
+
+    // opens tiles one after another from a worklist, with no pool, locks or task overhead
+    class SequentialReveal final {
+    public:
+        explicit SequentialReveal(std::size_t) noexcept { }
+        template<typename Board>
+        void open(Board& board, std::span<const TileCoordinates> tiles);
+        template<typename Function>
+        void synchronised(Function&& function);
+    };
+
+    inline ParallelReveal::ParallelReveal(const std::size_t storageSize): m_tileLocks(storageSize) { }
+
+    template<typename Board>
+    void ParallelReveal::open(Board& board, const std::span<const TileCoordinates> tiles) {
+        for (const auto& [row, column]: tiles) {
+            m_threadPool.detach_task([this, &board, row, column] {
+                openFrom(board, row, column);
+            });
+        }
+        m_threadPool.wait();
+    }
+
+    template<typename Board>
+    void ParallelReveal::openFrom(Board& board, const std::uint8_t row, const std::uint8_t column) {
+        // neighbours inside the same layout block are opened by this task straight away, only the ones across a
+        // block edge become new tasks, so a blocked layout keeps each task on a few cache lines
+        using Layout = typename Board::StorageType::Layout;
+        constexpr std::size_t blockCapacity{
+            Board::TopologyType::maxNeighbours * Layout::blockSide * Layout::blockSide + 1
+        };
+        std::array<TileCoordinates, blockCapacity> blockTiles;
+        std::size_t blockTileAmount{0};
+        blockTiles[blockTileAmount++] = {row, column};
+        while (blockTileAmount > 0) {
+            const auto [r, c]{blockTiles[--blockTileAmount]};
+            const std::unique_lock tileLock{m_tileLocks[board.gridToStorage(r, c)], std::try_to_lock};
+            if (!tileLock.owns_lock() || !board.openTile(r, c)) {
+                // if another thread is running on this tile it is taken care of, and only zeros spread further
+                continue;
+            }
+            Board::TopologyType::forEachNeighbour(board.getRowAmount(), board.getColumnAmount(), r, c,
+                                                  [&](const std::uint8_t nRow, const std::uint8_t nColumn) {
+                                                      if (nRow / Layout::blockSide == r / Layout::blockSide
+                                                          && nColumn / Layout::blockSide == c / Layout::blockSide
+                                                          && Layout::blockSide > 1) {
+                                                          blockTiles[blockTileAmount++] = {nRow, nColumn};
+                                                          return;
+                                                      }
+                                                      m_threadPool.detach_task([this, &board, nRow, nColumn] {
+                                                          openFrom(board, nRow, nColumn);
+                                                      });
+                                                  });
+        }
+    }
+
+    template<typename Function>
+    void ParallelReveal::synchronised(Function&& function) {
+        const std::lock_guard sharedLock{m_sharedMutex};
+        function();
+    }
+
+    template<typename Board>
+    void SequentialReveal::open(Board& board, const std::span<const TileCoordinates> tiles) {
+        std::vector<TileCoordinates> pending(tiles.begin(), tiles.end());
+        while (!pending.empty()) {
+            const auto [row, column]{pending.back()};
+            pending.pop_back();
+            if (!board.openTile(row, column)) {
+                continue;
+            }
+            Board::TopologyType::forEachNeighbour(board.getRowAmount(), board.getColumnAmount(), row, column,
+                                                  [&](const std::uint8_t r, const std::uint8_t c) {
+                                                      pending.emplace_back(r, c);
+                                                  });
+        }
+    }
+
+    template<typename Function>
+    void SequentialReveal::synchronised(Function&& function) {
+        function();
+    }
+} // Minesweeper
+
+#endif //REVEALPOLICY_HPP
@@ -0,0 +1,258 @@
+#include "RolloutGuesser.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#ifndef _MSC_VER
+#define PCG_RAND
+#include <pcg/pcg_extras.hpp>
+#include <pcg/pcg_random.hpp>
+#endif
+#include <random>
+#include <tuple>
+#include <utility>
+
+namespace Minesweeper {
+    template<typename Topology>
+    BasicRolloutGuesser<Topology>::BasicRolloutGuesser(BS::thread_pool* const threadPool,
+                                                       const std::chrono::microseconds budget,
+                                                       const std::size_t candidateAmount, const std::size_t guessLimit,
+                                                       const std::uint64_t seed):
+        m_threadPool{threadPool},
+        m_budget{budget},
+        m_candidateAmount{candidateAmount},
+        m_guessLimit{guessLimit},
+        m_seed{seed} {
+    }
+
+    // The guess for the position the probabilities were last computed for, or nothing if no hidden tile is left.
+    // The safest candidate goes back unplayed when it is certain to be safe, stands alone, or no layouts can be
+    // drawn, which includes listing them taking up the whole budget; a budget of zero also plays nothing.
+    template<typename Topology>
+    std::optional<typename BasicRolloutGuesser<Topology>::Guess> BasicRolloutGuesser<Topology>::guess(
+        const BasicSolver<Topology>& solver, BasicProbabilitySolver<Topology>& probabilities,
+        const std::uint16_t mineCount) {
+        const auto deadline{std::chrono::steady_clock::now() + m_budget};
+        const std::uint8_t columnAmount{solver.getColumnAmount()};
+        const std::size_t size{static_cast<std::size_t>(solver.getRowAmount()) * columnAmount};
+        const auto coordinates{[&](const std::size_t index) {
+            return TileCoordinates{static_cast<std::uint8_t>(index / columnAmount),
+                                   static_cast<std::uint8_t>(index % columnAmount)};
+        }};
+        const auto probabilityOf{[&](const std::size_t index) {
+            return probabilities.probabilityAt(static_cast<std::uint8_t>(index / columnAmount),
+                                               static_cast<std::uint8_t>(index % columnAmount));
+        }};
+
+        std::size_t revealed{0};
+        m_candidates.clear();
+        for (std::size_t index{0}; index < size; index++) {
+            if (solver.viewAt(index) <= Topology::maxNeighbours) {
+                revealed++;
+            } else if (solver.viewAt(index) == BasicSolver<Topology>::hidden && !solver.isKnownMine(index)) {
+                m_candidates.push_back(static_cast<std::uint16_t>(index));
+            }
+        }
+        if (m_candidates.empty()) {
+            return std::nullopt;
+        }
+        // among equally likely tiles those with fewer neighbours, which more often open up
+        const std::size_t candidateAmount{std::min(m_candidateAmount, m_candidates.size())};
+        std::ranges::partial_sort(m_candidates, m_candidates.begin() + static_cast<std::ptrdiff_t>(candidateAmount),
+                                  {}, [&](const std::uint16_t index) {
+                                      return std::tuple{probabilityOf(index), solver.neighboursOf(index).size(), index};
+                                  });
+        m_candidates.resize(candidateAmount);
+        const Guess safest{coordinates(m_candidates.front()), 1.0 - probabilityOf(m_candidates.front()), 0};
+        if (candidateAmount == 1 || safest.score == 1.0 || m_budget <= std::chrono::microseconds::zero() ||
+            !probabilities.prepareSampling(BasicProbabilitySolver<Topology>::defaultLayoutLimit, deadline)) {
+            return safest;
+        }
+
+        // the rollouts of a candidate sum up only over the layouts where it is safe, which its exact probability
+        // then stands in for, so the draw only adds noise to what happens after the click
+        const std::size_t workerAmount{
+            m_threadPool != nullptr ? std::max<std::size_t>(m_threadPool->get_thread_count(), 1) : 1
+        };
+        std::vector<std::vector<Tally>> tallies(workerAmount, std::vector<Tally>(candidateAmount));
+        std::vector<std::size_t> layoutAmounts(workerAmount, 0);
+        const std::uint64_t seed{m_seed + m_decisions++};
+        const auto playOut{[&](const std::size_t worker) {
+            #ifdef PCG_RAND
+            pcg32 generator{seed, worker};
+            #else
+            std::minstd_rand generator{static_cast<std::minstd_rand::result_type>(seed * workerAmount + worker + 1)};
+            #endif
+            std::vector<std::uint8_t> mines{};
+            std::vector<float> crowding{};
+            std::vector<double> layoutScores(candidateAmount, 0.0);
+            while (std::chrono::steady_clock::now() < deadline) {
+                probabilities.sampleLayout(generator, mines);
+                // a layout counts only once every candidate has been played in it
+                std::size_t played{0};
+                for (; played < candidateAmount && std::chrono::steady_clock::now() < deadline; played++) {
+                    layoutScores[played] = rollout(solver, mines, revealed, size - mineCount, m_candidates[played],
+                                                   crowding);
+                }
+                if (played < candidateAmount) {
+                    break;
+                }
+                for (std::size_t candidate{0}; candidate < candidateAmount; candidate++) {
+                    if (mines[m_candidates[candidate]] == 0) {
+                        Tally& tally{tallies[worker][candidate]};
+                        tally.sum += layoutScores[candidate];
+                        tally.squares += layoutScores[candidate] * layoutScores[candidate];
+                        tally.amount++;
+                    }
+                }
+                layoutAmounts[worker]++;
+            }
+        }};
+        if (m_threadPool != nullptr) {
+            m_threadPool->submit_sequence(std::size_t{0}, workerAmount, playOut).wait();
+        } else {
+            playOut(0);
+        }
+
+        std::size_t layoutAmount{0};
+        for (const std::size_t amount: layoutAmounts) {
+            layoutAmount += amount;
+        }
+        if (layoutAmount == 0) {
+            return safest;
+        }
+        // a few dozen layouts leave the estimates noisy, and the best of several noisy estimates is usually just the
+        // luckiest, so the safest candidate only gives way to one that beats it by two standard errors
+        const auto estimate{[&](const std::size_t candidate) {
+            Tally total{};
+            for (std::size_t worker{0}; worker < workerAmount; worker++) {
+                total.sum += tallies[worker][candidate].sum;
+                total.squares += tallies[worker][candidate].squares;
+                total.amount += tallies[worker][candidate].amount;
+            }
+            if (total.amount < 2) {
+                return std::pair{0.0, std::numeric_limits<double>::infinity()};
+            }
+            const double amount{static_cast<double>(total.amount)};
+            const double mean{total.sum / amount};
+            const double variance{std::max(0.0, (total.squares - total.sum * mean) / (amount - 1.0))};
+            const double safe{1.0 - probabilityOf(m_candidates[candidate])};
+            return std::pair{safe * mean, safe * std::sqrt(variance / amount)};
+        }};
+        const auto [safestScore, safestError]{estimate(0)};
+        Guess best{safest.tile, safestScore, layoutAmount};
+        double bestMargin{0.0};
+        for (std::size_t candidate{1}; candidate < candidateAmount; candidate++) {
+            const auto [score, error]{estimate(candidate)};
+            const double margin{score - safestScore - 2.0 * std::sqrt(error * error + safestError * safestError)};
+            if (margin > bestMargin) {
+                bestMargin = margin;
+                best = Guess{coordinates(m_candidates[candidate]), score, layoutAmount};
+            }
+        }
+        return best;
+    }
+
+    // Plays the layout from a click on tile: whatever the solver deduces safe gets revealed with the number the
+    // layout puts there, and a stuck solver guesses the least crowded tile, up to the guess limit. Scores 1 for a
+    // cleared board, 0 for a mine and else the chance the next guess would be safe, by the same crowding.
+    template<typename Topology>
+    double BasicRolloutGuesser<Topology>::rollout(BasicSolver<Topology> solver, const std::vector<std::uint8_t>& mines,
+                                                  std::size_t revealed, const std::size_t safeAmount,
+                                                  std::uint16_t tile, std::vector<float>& crowding) const {
+        const std::uint8_t columnAmount{solver.getColumnAmount()};
+        for (std::size_t guesses{0};; guesses++) {
+            if (mines[tile] != 0) {
+                return 0.0;
+            }
+            while (true) {
+                std::uint8_t number{0};
+                for (const std::uint16_t neighbour: solver.neighboursOf(tile)) {
+                    number += mines[neighbour];
+                }
+                solver.reveal(static_cast<std::uint8_t>(tile / columnAmount),
+                              static_cast<std::uint8_t>(tile % columnAmount), number);
+                revealed++;
+                solver.solve();
+                const std::optional<TileCoordinates> safe{solver.nextSafeTile()};
+                if (!safe) {
+                    break;
+                }
+                tile = static_cast<std::uint16_t>(safe->first * columnAmount + safe->second);
+            }
+            if (revealed == safeAmount) {
+                return 1.0;
+            }
+            float risk{0.0f};
+            const std::optional<std::uint16_t> next{leastCrowded(solver, mines.size() - safeAmount, crowding, risk)};
+            if (!next) {
+                return 0.0;
+            }
+            if (guesses == m_guessLimit) {
+                return 1.0 - risk;
+            }
+            tile = *next;
+        }
+    }
+
+    // The hidden tile whose most crowded revealed neighbour has the fewest missing mines per hidden tile, a tile no
+    // number sees counting with the mines left per hidden tile; risk is that share for the tile picked.
+    template<typename Topology>
+    std::optional<std::uint16_t> BasicRolloutGuesser<Topology>::leastCrowded(const BasicSolver<Topology>& solver,
+                                                                            const std::size_t hiddenMines,
+                                                                            std::vector<float>& crowding,
+                                                                            float& risk) {
+        const std::size_t size{static_cast<std::size_t>(solver.getRowAmount()) * solver.getColumnAmount()};
+        crowding.assign(size, 0.0f);
+        std::size_t placed{0};
+        std::size_t undecided{0};
+        for (std::size_t index{0}; index < size; index++) {
+            const std::uint8_t view{solver.viewAt(index)};
+            if (view == BasicSolver<Topology>::flagged || solver.isKnownMine(index)) {
+                placed++;
+            } else if (view == BasicSolver<Topology>::hidden) {
+                undecided++;
+            } else {
+                int missing{view};
+                int open{0};
+                for (const std::uint16_t neighbour: solver.neighboursOf(index)) {
+                    if (solver.viewAt(neighbour) == BasicSolver<Topology>::flagged || solver.isKnownMine(neighbour)) {
+                        missing--;
+                    } else if (solver.viewAt(neighbour) == BasicSolver<Topology>::hidden) {
+                        open++;
+                    }
+                }
+                crowding[index] = open > 0 ? static_cast<float>(missing) / static_cast<float>(open) : 0.0f;
+            }
+        }
+        if (undecided == 0) {
+            return std::nullopt;
+        }
+        const float density{static_cast<float>(hiddenMines - std::min(placed, hiddenMines)) /
+                            static_cast<float>(undecided)};
+        std::optional<std::uint16_t> best{};
+        risk = std::numeric_limits<float>::infinity();
+        for (std::size_t index{0}; index < size; index++) {
+            if (solver.viewAt(index) != BasicSolver<Topology>::hidden || solver.isKnownMine(index)) {
+                continue;
+            }
+            float crowded{-1.0f};
+            for (const std::uint16_t neighbour: solver.neighboursOf(index)) {
+                if (solver.viewAt(neighbour) <= Topology::maxNeighbours) {
+                    crowded = std::max(crowded, crowding[neighbour]);
+                }
+            }
+            crowded = crowded < 0.0f ? density : crowded;
+            if (crowded < risk) {
+                risk = crowded;
+                best = static_cast<std::uint16_t>(index);
+            }
+        }
+        return best;
+    }
+
+    template class BasicRolloutGuesser<RectangularTopology>;
+    template class BasicRolloutGuesser<TorusTopology>;
+    template class BasicRolloutGuesser<HexagonalTopology>;
+    template class BasicRolloutGuesser<KnightTopology>;
+} // Minesweeper
@@ -0,0 +1,76 @@
+#ifndef ROLLOUTGUESSER_HPP
+#define ROLLOUTGUESSER_HPP
+
+#include <BS_thread_pool.hpp> // https://github.com/bshoshany/thread-pool
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "ProbabilitySolver.hpp"
+#include "RevealPolicy.hpp"
+#include "Solver.hpp"
+
+
+namespace Minesweeper {
+    // Picks a guess by playing it out rather than by its odds alone. The few hidden tiles least likely to be mines
+    // are the candidates; layouts of the mines that fit the board are drawn from the probability solver, and every
+    // candidate is clicked in each of them and played on with a copy of the BasicSolver, which reveals what it
+    // deduces safe until it gets stuck, then clicks the tile the numbers around it make least crowded if it has
+    // guesses left. A rollout scores 1 when it clears the board, 0 when it hits a mine and otherwise the chance that
+    // its next click would be safe. Rollouts run until the time budget is spent, on every thread of the pool it is
+    // lent or else on the caller's, each worker drawing its layouts from its own PCG stream, and all candidates are
+    // scored on the same layouts, so their differences are not drowned out by the draw.
+    template<typename Topology>
+    class BasicRolloutGuesser final {
+    public:
+        struct Guess {
+            TileCoordinates tile;
+            double score; // an estimate of the chance of winning, see rollout()
+            std::size_t layoutAmount; // the layouts played, none if the candidates were not worth it
+        };
+
+    private:
+        // what a candidate's rollouts scored over the layouts where it was safe
+        struct Tally {
+            double sum{0.0};
+            double squares{0.0};
+            std::size_t amount{0};
+        };
+
+        BS::thread_pool* m_threadPool; // not owned, may be null
+        const std::chrono::microseconds m_budget;
+        const std::size_t m_candidateAmount;
+        const std::size_t m_guessLimit;
+        const std::uint64_t m_seed;
+        std::uint64_t m_decisions{0};
+        std::vector<std::uint16_t> m_candidates;
+
+        [[nodiscard]] double rollout(BasicSolver<Topology> solver, const std::vector<std::uint8_t>& mines,
+                                     std::size_t revealed, std::size_t safeAmount, std::uint16_t tile,
+                                     std::vector<float>& crowding) const;
+        [[nodiscard]] static std::optional<std::uint16_t> leastCrowded(const BasicSolver<Topology>& solver,
+                                                                       std::size_t hiddenMines,
+                                                                       std::vector<float>& crowding, float& risk);
+
+    public:
+        explicit BasicRolloutGuesser(BS::thread_pool* threadPool,
+                                     std::chrono::microseconds budget = std::chrono::milliseconds{10},
+                                     std::size_t candidateAmount = 6, std::size_t guessLimit = 0,
+                                     std::uint64_t seed = 0);
+        [[nodiscard]] std::optional<Guess> guess(const BasicSolver<Topology>& solver,
+                                                 BasicProbabilitySolver<Topology>& probabilities,
+                                                 std::uint16_t mineCount);
+        [[nodiscard]] std::chrono::microseconds getBudget() const noexcept;
+    };
+
+    using RolloutGuesser = BasicRolloutGuesser<RectangularTopology>;
+
+    template<typename Topology>
+    inline std::chrono::microseconds BasicRolloutGuesser<Topology>::getBudget() const noexcept {
+        return m_budget;
+    }
+} // Minesweeper
+
+#endif //ROLLOUTGUESSER_HPP
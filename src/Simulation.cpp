@@ -0,0 +1,78 @@
+#include "Simulation.hpp"
+
+#include <span>
+#include <vector>
+
+namespace Minesweeper {
+    Simulation::Worker::Worker(const std::uint8_t rowAmount, const std::uint8_t columnAmount,
+                               const std::uint16_t mineCount):
+        board{rowAmount, columnAmount, mineCount},
+        advisor{rowAmount, columnAmount, mineCount} {
+    }
+
+    Simulation::Simulation(const std::uint8_t rowAmount, const std::uint8_t columnAmount,
+                           const std::uint16_t mineCount, const std::size_t threadAmount, const std::uint64_t seed):
+        m_threadPool{static_cast<BS::concurrency_t>(threadAmount)},
+        m_seed{seed} {
+        for (std::size_t worker{0}; worker < m_threadPool.get_thread_count(); worker++) {
+            m_workers.emplace_back(rowAmount, columnAmount, mineCount);
+        }
+    }
+
+    // Plays the next gameAmount games, worker w taking games w, w + T, w + 2T and so on for T workers, and sums up
+    // what the workers counted; the games of a later run are dealt from the seeds after these.
+    Simulation::Results Simulation::run(const std::size_t gameAmount) {
+        const std::size_t workerAmount{m_workers.size()};
+        const auto start{std::chrono::steady_clock::now()};
+        m_threadPool.submit_sequence(std::size_t{0}, workerAmount, [&](const std::size_t index) {
+            Worker& worker{m_workers[index]};
+            worker.results = Results{};
+            for (std::size_t game{index}; game < gameAmount; game += workerAmount) {
+                play(worker, m_seed + game);
+            }
+        }).wait();
+
+        Results total{};
+        for (const Worker& worker: m_workers) {
+            total.games += worker.results.games;
+            total.wins += worker.results.wins;
+            total.clicks += worker.results.clicks;
+            total.threeBV += worker.results.threeBV;
+        }
+        total.elapsed = std::chrono::steady_clock::now() - start;
+        m_seed += gameAmount;
+        return total;
+    }
+
+    // one game on the worker's board, fed to its advisor a change list at a time until it is won, lost, or the
+    // advisor finds the flags contradict the numbers
+    void Simulation::play(Worker& worker, const std::uint64_t seed) {
+        RecordedBoard& board{worker.board};
+        board.reset();
+        board.getObserver().clear();
+        board.setSeed(seed);
+        worker.advisor.reset();
+        std::size_t seen{0};
+        TileCoordinates next{static_cast<std::uint8_t>(board.getRowAmount() / 2),
+                             static_cast<std::uint8_t>(board.getColumnAmount() / 2)};
+        while (true) {
+            board.checkTile(next.first, next.second);
+            worker.results.clicks++;
+            if (board.hitMine() || board.foundAllMines()) {
+                break;
+            }
+            const std::vector<TileChange>& recorded{board.getObserver().getChanges()};
+            const auto advice{worker.advisor.advise(board, std::span{recorded}.subspan(seen))};
+            seen = recorded.size();
+            if (!advice) {
+                break;
+            }
+            next = advice->tile;
+        }
+        worker.results.games++;
+        if (board.foundAllMines()) {
+            worker.results.wins++;
+            worker.results.threeBV += board.computeMetrics().threeBV;
+        }
+    }
+} // Minesweeper
@@ -0,0 +1,86 @@
+#ifndef SIMULATION_HPP
+#define SIMULATION_HPP
+
+#include <BS_thread_pool.hpp> // https://github.com/bshoshany/thread-pool
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+#include "Advisor.hpp"
+#include "Board.hpp"
+#include "Observer.hpp"
+#include "RevealPolicy.hpp"
+#include "Storage.hpp"
+
+
+namespace Minesweeper {
+    // Plays games with the BasicAdvisor and nobody watching, to measure how well and how fast the solvers play.
+    // Every worker thread owns a board and an advisor and plays its share of the games on them, resetting both in
+    // place between games, so a worker neither allocates nor touches anything another worker writes until it hands
+    // its results back. The advisors get no thread pool: a worker is already one thread of many, and handing its
+    // components to another thread would only add a round trip to every move. Game i is always dealt from seed + i
+    // and opened in the middle, so the results do not depend on the thread amount.
+    class Simulation final {
+    public:
+        struct Results {
+            std::size_t games{0};
+            std::size_t wins{0};
+            std::size_t clicks{0}; // tiles checked, the first click included
+            std::uint64_t threeBV{0}; // of the games won
+            std::chrono::steady_clock::duration elapsed{};
+
+            [[nodiscard]] double winRate() const noexcept;
+            [[nodiscard]] double meanClicks() const noexcept;
+            [[nodiscard]] double threeBVPerSecond() const noexcept;
+            [[nodiscard]] double gamesPerSecond() const noexcept;
+        };
+
+    private:
+        using RecordedBoard = BasicBoard<VectorStorage<>, RectangularTopology, SequentialReveal, ChangeRecorder>;
+
+        struct Worker {
+            RecordedBoard board;
+            Advisor advisor;
+            Results results{};
+
+            explicit Worker(std::uint8_t rowAmount, std::uint8_t columnAmount, std::uint16_t mineCount);
+        };
+
+        BS::thread_pool m_threadPool;
+        std::deque<Worker> m_workers; // a deque, since neither boards nor advisors can move
+        std::uint64_t m_seed;
+
+        void play(Worker& worker, std::uint64_t seed);
+
+    public:
+        explicit Simulation(std::uint8_t rowAmount, std::uint8_t columnAmount, std::uint16_t mineCount,
+                            std::size_t threadAmount = 0, std::uint64_t seed = 0);
+        [[nodiscard]] Results run(std::size_t gameAmount);
+        [[nodiscard]] std::size_t getThreadAmount() const noexcept;
+    };
+
+    inline double Simulation::Results::winRate() const noexcept {
+        return games == 0 ? 0.0 : static_cast<double>(wins) / static_cast<double>(games);
+    }
+
+    inline double Simulation::Results::meanClicks() const noexcept {
+        return games == 0 ? 0.0 : static_cast<double>(clicks) / static_cast<double>(games);
+    }
+
+    inline double Simulation::Results::threeBVPerSecond() const noexcept {
+        const double seconds{std::chrono::duration<double>(elapsed).count()};
+        return seconds == 0.0 ? 0.0 : static_cast<double>(threeBV) / seconds;
+    }
+
+    inline double Simulation::Results::gamesPerSecond() const noexcept {
+        const double seconds{std::chrono::duration<double>(elapsed).count()};
+        return seconds == 0.0 ? 0.0 : static_cast<double>(games) / seconds;
+    }
+
+    inline std::size_t Simulation::getThreadAmount() const noexcept {
+        return m_workers.size();
+    }
+} // Minesweeper
+
+#endif //SIMULATION_HPP
@@ -0,0 +1,93 @@
+#include "SliceComponentBase.hpp"
+
+#include <array>
+#include <format>
+
+namespace Minesweeper {
+    SliceComponentBase::SliceComponentBase(const std::shared_ptr<VolumeBoard>& board,
+                                           ftxui::Closure exit): ComponentBase(),
+                                                                 m_exit{std::move(exit)},
+                                                                 m_board{board} { }
+
+    ftxui::Element SliceComponentBase::renderTile(const VolumeBoard::Coordinates& coordinates) const {
+        using namespace ftxui;
+        if (!m_board->isChecked(coordinates)) {
+            if (m_board->isFlagged(coordinates)) {
+                return text(" P") | color(Color::Red) | bgcolor(Color::GrayLight);
+            }
+            return text("[]") | color(Color::GrayDark) | bgcolor(Color::GrayLight);
+        }
+        if (m_board->isMine(coordinates)) {
+            return text(" *") | color(Color::Black) | bgcolor(Color::GrayDark);
+        }
+        const std::uint8_t surroundingMines{m_board->getSurroundingMines(coordinates)};
+        if (surroundingMines == 0) {
+            return text("  ") | bgcolor(Color::GrayDark);
+        }
+        // counts reach 26 in three dimensions, so the palette repeats every 8
+        static const std::array<Color, 8> palette{
+            Color::BlueLight, Color::Green, Color::RedLight, Color::Blue,
+            Color::Red, Color::Cyan, Color::Black, Color::GrayLight
+        };
+        return text(std::format("{:2}", surroundingMines)) | color(palette[(surroundingMines - 1) % palette.size()])
+               | bgcolor(Color::GrayDark);
+    }
+
+    ftxui::Element SliceComponentBase::Render() {
+        const auto& [columnAmount, rowAmount, layerAmount]{m_board->getExtents()};
+        ftxui::Elements rows;
+        rows.reserve(rowAmount);
+        for (std::uint16_t row{0}; row < rowAmount; row++) {
+            ftxui::Elements tiles;
+            tiles.reserve(columnAmount);
+            for (std::uint16_t col{0}; col < columnAmount; col++) {
+                tiles.push_back(renderTile({col, row, m_layer}));
+            }
+            rows.push_back(ftxui::hbox(std::move(tiles)));
+        }
+        return ftxui::vbox({
+            ftxui::text(std::format("Layer {}/{}  ([ and ] to change)", m_layer + 1, layerAmount)),
+            ftxui::separator(),
+            ftxui::vbox(std::move(rows)) | ftxui::reflect(m_box)
+        });
+    }
+
+    bool SliceComponentBase::OnEvent(ftxui::Event event) {
+        const std::uint16_t layerAmount{m_board->getExtents()[2]};
+        if (event == ftxui::Event::Character('[')) {
+            m_layer = static_cast<std::uint16_t>(m_layer == 0 ? layerAmount - 1 : m_layer - 1);
+            return true;
+        }
+        if (event == ftxui::Event::Character(']')) {
+            m_layer = static_cast<std::uint16_t>(m_layer + 1 == layerAmount ? 0 : m_layer + 1);
+            return true;
+        }
+        if (!event.is_mouse() || !m_box.Contain(event.mouse().x, event.mouse().y)) {
+            return false;
+        }
+        auto [button, motion, shift, meta, control, x, y]{event.mouse()};
+        if (motion != ftxui::Mouse::Motion::Released) {
+            return true;
+        }
+        const VolumeBoard::Coordinates coordinates{
+            static_cast<std::uint16_t>((x - m_box.x_min) / 2), static_cast<std::uint16_t>(y - m_box.y_min), m_layer
+        };
+        switch (button) {
+            case ftxui::Mouse::Left:
+                m_board->checkTile(coordinates);
+                break;
+            case ftxui::Mouse::Middle:
+                m_board->clearSafeTiles(coordinates);
+                break;
+            case ftxui::Mouse::Right:
+                m_board->toggleFlag(coordinates);
+                break;
+            default:
+                break;
+        }
+        if (m_board->foundAllMines() || m_board->hitMine()) {
+            m_exit();
+        }
+        return true;
+    }
+} // Minesweeper
@@ -0,0 +1,45 @@
+#ifndef SLICECOMPONENT_HPP
+#define SLICECOMPONENT_HPP
+
+#include <ftxui/component/component.hpp>
+#include <ftxui/screen/box.hpp>
+
+#include "NdBoard.hpp"
+
+
+namespace Minesweeper {
+    class SliceComponentBase;
+    using SliceComponent = std::shared_ptr<SliceComponentBase>;
+
+    // Renders one layer of a VolumeBoard at a time; '[' and ']' move between layers.
+    class SliceComponentBase final : public ftxui::ComponentBase {
+        ftxui::Closure m_exit;
+        std::shared_ptr<VolumeBoard> m_board;
+        ftxui::Box m_box{};
+        std::uint16_t m_layer{0};
+
+        [[nodiscard]] ftxui::Element renderTile(const VolumeBoard::Coordinates& coordinates) const;
+
+    public:
+        static SliceComponent Create(const std::shared_ptr<VolumeBoard>& board, ftxui::Closure exit);
+        explicit SliceComponentBase(const std::shared_ptr<VolumeBoard>& board, ftxui::Closure exit);
+        [[nodiscard]] std::uint16_t getLayer() const noexcept;
+        ftxui::Element Render() override;
+        bool OnEvent(ftxui::Event) override;
+        [[nodiscard]] constexpr bool Focusable() const override;
+    };
+
+    constexpr bool SliceComponentBase::Focusable() const {
+        return true;
+    }
+
+    inline SliceComponent SliceComponentBase::Create(const std::shared_ptr<VolumeBoard>& board, ftxui::Closure exit) {
+        return std::make_shared<SliceComponentBase>(board, std::move(exit));
+    }
+
+    inline std::uint16_t SliceComponentBase::getLayer() const noexcept {
+        return m_layer;
+    }
+} // Minesweeper
+
+#endif //SLICECOMPONENT_HPP
@@ -0,0 +1,257 @@
+#include "Solver.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace Minesweeper {
+    template<typename Topology>
+    BasicSolver<Topology>::BasicSolver(const std::uint8_t rowAmount, const std::uint8_t columnAmount):
+        m_neighbours(rowAmount * columnAmount),
+        m_neighbourAmounts(rowAmount * columnAmount, 0),
+        m_view(rowAmount * columnAmount, hidden),
+        m_facts(rowAmount * columnAmount, Fact::unknown),
+        m_queued(rowAmount * columnAmount, 0),
+        m_marks(rowAmount * columnAmount, 0),
+        m_rowAmount{rowAmount},
+        m_columnAmount{columnAmount} {
+        // the same as for the board: a torus narrower than three would list a neighbour twice
+        assert(!Topology::wraps || (rowAmount >= 3 && columnAmount >= 3));
+        for (std::uint8_t row{0}; row < m_rowAmount; row++) {
+            for (std::uint8_t column{0}; column < m_columnAmount; column++) {
+                const std::size_t index{static_cast<std::size_t>(row * m_columnAmount + column)};
+                Topology::forEachNeighbour(m_rowAmount, m_columnAmount, row, column,
+                                           [&](const std::uint8_t r, const std::uint8_t c) {
+                                               m_neighbours[index][m_neighbourAmounts[index]++] =
+                                                   static_cast<std::uint16_t>(r * m_columnAmount + c);
+                                           });
+            }
+        }
+    }
+
+    template<typename Topology>
+    void BasicSolver<Topology>::reveal(const std::uint8_t row, const std::uint8_t column,
+                                       const std::uint8_t surroundingMines) {
+        assert(surroundingMines <= Topology::maxNeighbours);
+        const std::size_t index{static_cast<std::size_t>(row * m_columnAmount + column)};
+        if (m_view[index] == surroundingMines) {
+            return;
+        }
+        m_view[index] = surroundingMines;
+        enqueue(index);
+        enqueueAround(index);
+    }
+
+    template<typename Topology>
+    void BasicSolver<Topology>::flag(const std::uint8_t row, const std::uint8_t column) {
+        const std::size_t index{static_cast<std::size_t>(row * m_columnAmount + column)};
+        if (m_view[index] != hidden) {
+            return;
+        }
+        m_view[index] = flagged;
+        enqueueAround(index);
+    }
+
+    template<typename Topology>
+    void BasicSolver<Topology>::unflag(const std::uint8_t row, const std::uint8_t column) {
+        const std::size_t index{static_cast<std::size_t>(row * m_columnAmount + column)};
+        if (m_view[index] != flagged) {
+            return;
+        }
+        m_view[index] = hidden;
+        withdrawFacts();
+    }
+
+    // takes a fact about a hidden tile worked out elsewhere, such as by the probability solver's parity elimination,
+    // and deduces from it like from its own; solve() carries it on to the numbers around the tile
+    template<typename Topology>
+    void BasicSolver<Topology>::settle(const std::size_t index, const bool mine) {
+        if (m_view[index] != hidden) {
+            return;
+        }
+        deduce(index, mine ? Fact::mine : Fact::safe);
+    }
+
+    // Runs the worklists dry and returns how many tiles got settled. Pairs are only tried once no number settles
+    // anything on its own, since the cheap check usually empties a constraint before its pairs would be needed.
+    template<typename Topology>
+    std::size_t BasicSolver<Topology>::solve() {
+        const std::size_t before{m_safeTiles.size() + m_mineTiles.size()};
+        while (true) {
+            if (!m_worklist.empty()) {
+                const std::uint16_t index{m_worklist.back()};
+                m_worklist.pop_back();
+                m_queued[index] &= ~queuedSingle;
+                examineSingle(index);
+            } else if (!m_pairWorklist.empty()) {
+                const std::uint16_t index{m_pairWorklist.back()};
+                m_pairWorklist.pop_back();
+                m_queued[index] &= ~queuedPairs;
+                examinePairs(index);
+            } else {
+                break;
+            }
+        }
+        return m_safeTiles.size() + m_mineTiles.size() - before;
+    }
+
+    // the cursor only moves past tiles already revealed, so a safe tile that was handed out but not clicked, say
+    // as a hint the player ignored, is handed out again
+    template<typename Topology>
+    std::optional<TileCoordinates> BasicSolver<Topology>::nextSafeTile() noexcept {
+        for (; m_nextSafe < m_safeTiles.size(); m_nextSafe++) {
+            const std::uint16_t index{m_safeTiles[m_nextSafe]};
+            if (m_view[index] == hidden) {
+                return TileCoordinates{static_cast<std::uint8_t>(index / m_columnAmount),
+                                       static_cast<std::uint8_t>(index % m_columnAmount)};
+            }
+        }
+        return std::nullopt;
+    }
+
+    template<typename Topology>
+    void BasicSolver<Topology>::reset() {
+        std::ranges::fill(m_view, hidden);
+        std::ranges::fill(m_facts, Fact::unknown);
+        std::ranges::fill(m_queued, 0);
+        m_safeTiles.clear();
+        m_mineTiles.clear();
+        m_worklist.clear();
+        m_pairWorklist.clear();
+        m_nextSafe = 0;
+    }
+
+    template<typename Topology>
+    typename BasicSolver<Topology>::Constraint BasicSolver<Topology>::constraintOf(
+        const std::size_t index) const noexcept {
+        Constraint constraint{};
+        constraint.mines = static_cast<std::int8_t>(m_view[index]);
+        for (std::uint8_t i{0}; i < m_neighbourAmounts[index]; i++) {
+            // branch free, the neighbours' states are too mixed for the predictor
+            const std::uint16_t neighbour{m_neighbours[index][i]};
+            constraint.mines -= (m_view[neighbour] == flagged) | (m_facts[neighbour] == Fact::mine);
+            constraint.tiles[constraint.size] = neighbour;
+            constraint.size += isOpen(neighbour);
+        }
+        return constraint;
+    }
+
+    // settles the hidden neighbours of the number at index if its remaining mines are none or all of them, and
+    // otherwise leaves it for examinePairs()
+    template<typename Topology>
+    void BasicSolver<Topology>::examineSingle(const std::size_t index) {
+        const Constraint own{constraintOf(index)};
+        if (own.size == 0 || own.mines < 0 || own.mines > own.size) {
+            return; // nothing left to settle, or flags that contradict the number
+        }
+        if (own.mines == 0 || own.mines == own.size) {
+            for (std::uint8_t i{0}; i < own.size; i++) {
+                deduce(own.tiles[i], own.mines == 0 ? Fact::safe : Fact::mine);
+            }
+        } else if ((m_queued[index] & queuedPairs) == 0) {
+            m_queued[index] |= queuedPairs;
+            m_pairWorklist.push_back(static_cast<std::uint16_t>(index));
+        }
+    }
+
+    // Settles what the number at index proves together with one of the numbers sharing a tile with it. For two
+    // constraints a and b, b's mines minus a's mines can only reach the amount of tiles b sees and a doesn't if all
+    // of those are mines and none of the tiles only a sees is. One proof per call is enough: settling a tile next
+    // to this number queues it again.
+    template<typename Topology>
+    void BasicSolver<Topology>::examinePairs(const std::size_t index) {
+        const Constraint own{constraintOf(index)};
+        if (own.mines <= 0 || own.mines >= own.size) {
+            return; // settled on its own by now, or contradicted
+        }
+
+        // own tiles are marked with the epoch and the numbers already paired with epoch + 1; the two never mix,
+        // as one kind is hidden and the other revealed
+        m_epoch += 2;
+        if (m_epoch < 2) {
+            std::ranges::fill(m_marks, 0);
+            m_epoch = 2;
+        }
+        for (std::uint8_t i{0}; i < own.size; i++) {
+            m_marks[own.tiles[i]] = m_epoch;
+        }
+        for (std::uint8_t i{0}; i < own.size; i++) {
+            const std::uint16_t shared{own.tiles[i]};
+            for (std::uint8_t j{0}; j < m_neighbourAmounts[shared]; j++) {
+                const std::uint16_t other{m_neighbours[shared][j]};
+                if (other == index || m_view[other] > Topology::maxNeighbours || m_marks[other] == m_epoch + 1) {
+                    continue;
+                }
+                m_marks[other] = m_epoch + 1;
+                const Constraint theirs{constraintOf(other)};
+                if (theirs.mines < 0 || theirs.mines > theirs.size) {
+                    continue;
+                }
+                std::uint8_t sharedAmount{0};
+                for (std::uint8_t k{0}; k < theirs.size; k++) {
+                    sharedAmount += m_marks[theirs.tiles[k]] == m_epoch;
+                }
+                const int onlyOwn{own.size - sharedAmount};
+                const int onlyTheirs{theirs.size - sharedAmount};
+                const bool theirsAreMines{theirs.mines - own.mines == onlyTheirs};
+                const bool ownAreMines{own.mines - theirs.mines == onlyOwn};
+                if (onlyOwn + onlyTheirs == 0 || (!theirsAreMines && !ownAreMines)) {
+                    continue;
+                }
+                for (std::uint8_t k{0}; k < theirs.size; k++) {
+                    if (m_marks[theirs.tiles[k]] != m_epoch) {
+                        deduce(theirs.tiles[k], theirsAreMines ? Fact::mine : Fact::safe);
+                    }
+                }
+                for (std::uint8_t k{0}; k < own.size; k++) {
+                    if (std::find(theirs.tiles.begin(), theirs.tiles.begin() + theirs.size, own.tiles[k]) ==
+                        theirs.tiles.begin() + theirs.size) {
+                        deduce(own.tiles[k], ownAreMines ? Fact::mine : Fact::safe);
+                    }
+                }
+                return;
+            }
+        }
+    }
+
+    template<typename Topology>
+    void BasicSolver<Topology>::deduce(const std::size_t index, const Fact fact) {
+        if (m_facts[index] != Fact::unknown) {
+            return;
+        }
+        m_facts[index] = fact;
+        (fact == Fact::safe ? m_safeTiles : m_mineTiles).push_back(static_cast<std::uint16_t>(index));
+        enqueueAround(index);
+    }
+
+    template<typename Topology>
+    void BasicSolver<Topology>::enqueue(const std::size_t index) {
+        if (m_view[index] > Topology::maxNeighbours || (m_queued[index] & queuedSingle) != 0) {
+            return;
+        }
+        m_queued[index] |= queuedSingle;
+        m_worklist.push_back(static_cast<std::uint16_t>(index));
+    }
+
+    template<typename Topology>
+    void BasicSolver<Topology>::enqueueAround(const std::size_t index) {
+        for (std::uint8_t i{0}; i < m_neighbourAmounts[index]; i++) {
+            enqueue(m_neighbours[index][i]);
+        }
+    }
+
+    template<typename Topology>
+    void BasicSolver<Topology>::withdrawFacts() {
+        std::ranges::fill(m_facts, Fact::unknown);
+        m_safeTiles.clear();
+        m_mineTiles.clear();
+        m_nextSafe = 0;
+        for (std::size_t index{0}; index < m_view.size(); index++) {
+            enqueue(index);
+        }
+    }
+
+    template class BasicSolver<RectangularTopology>;
+    template class BasicSolver<TorusTopology>;
+    template class BasicSolver<HexagonalTopology>;
+    template class BasicSolver<KnightTopology>;
+} // Minesweeper
@@ -0,0 +1,237 @@
+#ifndef SOLVER_HPP
+#define SOLVER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "Observer.hpp"
+#include "RevealPolicy.hpp"
+#include "Tile.hpp"
+#include "Topology.hpp"
+
+
+namespace Minesweeper {
+    // Deterministic deductions from what a player can see: the numbers of the revealed tiles and the flags, which
+    // are taken to be mines. Every revealed number is a constraint on its hidden neighbours; a constraint whose
+    // remaining mines are zero or fill all of its hidden tiles settles them (single-point), and two constraints
+    // sharing hidden tiles settle the tiles only one of them sees when their mine difference forces it (subset,
+    // which covers the 1-2 and 1-2-1 patterns). The solver keeps its own copy of the visible board and worklists
+    // of constraints touched since the last solve(), so after a move only the numbers around the changed tiles are
+    // looked at again. Removing a flag withdraws everything deduced so far, since any of it may have relied on it.
+    template<typename Topology>
+    class BasicSolver final {
+        enum class Fact : std::uint8_t {
+            unknown,
+            safe,
+            mine
+        };
+
+        // the hidden, undecided neighbours of a revealed number and how many mines are still missing among them
+        struct Constraint {
+            std::array<std::uint16_t, Topology::maxNeighbours> tiles;
+            std::uint8_t size{0};
+            std::int8_t mines{0};
+        };
+
+        static constexpr std::uint8_t queuedSingle{1};
+        static constexpr std::uint8_t queuedPairs{2};
+
+        std::vector<std::array<std::uint16_t, Topology::maxNeighbours>> m_neighbours;
+        std::vector<std::uint8_t> m_neighbourAmounts;
+        std::vector<std::uint8_t> m_view;
+        std::vector<Fact> m_facts;
+        std::vector<std::uint16_t> m_safeTiles; // in the order they were deduced, some may be revealed by now
+        std::vector<std::uint16_t> m_mineTiles;
+        std::vector<std::uint16_t> m_worklist; // numbers to check on their own
+        std::vector<std::uint16_t> m_pairWorklist; // numbers to check against the numbers around them
+        std::vector<std::uint8_t> m_queued; // which worklists a number is on, as queuedSingle | queuedPairs
+        std::vector<std::uint32_t> m_marks; // scratch for examinePairs(), valid where equal to m_epoch or one past
+        std::uint32_t m_epoch{0};
+        std::size_t m_nextSafe{0};
+        const std::uint8_t m_rowAmount;
+        const std::uint8_t m_columnAmount;
+
+        [[nodiscard]] Constraint constraintOf(std::size_t index) const noexcept;
+        [[nodiscard]] bool isOpen(std::size_t index) const noexcept;
+        void examineSingle(std::size_t index);
+        void examinePairs(std::size_t index);
+        void deduce(std::size_t index, Fact fact);
+        void enqueue(std::size_t index);
+        void enqueueAround(std::size_t index);
+        void withdrawFacts();
+
+    public:
+        static constexpr std::uint8_t hidden{0xFF};
+        static constexpr std::uint8_t flagged{0xFE};
+
+        explicit BasicSolver(std::uint8_t rowAmount, std::uint8_t columnAmount);
+        [[nodiscard]] std::uint8_t getRowAmount() const noexcept;
+        [[nodiscard]] std::uint8_t getColumnAmount() const noexcept;
+        [[nodiscard]] std::uint8_t viewAt(std::uint8_t row, std::uint8_t column) const noexcept;
+        [[nodiscard]] std::uint8_t viewAt(std::size_t index) const noexcept;
+        void reveal(std::uint8_t row, std::uint8_t column, std::uint8_t surroundingMines);
+        void flag(std::uint8_t row, std::uint8_t column);
+        void unflag(std::uint8_t row, std::uint8_t column);
+        void settle(std::size_t index, bool mine);
+        template<typename Board>
+        void observe(const Board& board);
+        template<typename Board>
+        void observe(const Board& board, std::span<const TileChange> changes);
+        std::size_t solve();
+        [[nodiscard]] bool isKnownSafe(std::uint8_t row, std::uint8_t column) const noexcept;
+        [[nodiscard]] bool isKnownMine(std::uint8_t row, std::uint8_t column) const noexcept;
+        [[nodiscard]] bool isKnownSafe(std::size_t index) const noexcept;
+        [[nodiscard]] bool isKnownMine(std::size_t index) const noexcept;
+        [[nodiscard]] std::span<const std::uint16_t> neighboursOf(std::size_t index) const noexcept;
+        [[nodiscard]] std::size_t getSafeAmount() const noexcept;
+        [[nodiscard]] std::size_t getMineAmount() const noexcept;
+        [[nodiscard]] std::span<const std::uint16_t> getSafeTiles() const noexcept;
+        [[nodiscard]] std::span<const std::uint16_t> getMineTiles() const noexcept;
+        [[nodiscard]] std::optional<TileCoordinates> nextSafeTile() noexcept;
+        template<typename Function>
+        void forEachSafeTile(Function&& function) const;
+        template<typename Function>
+        void forEachMineTile(Function&& function) const;
+        void reset();
+    };
+
+    using Solver = BasicSolver<RectangularTopology>;
+
+    template<typename Topology>
+    inline std::uint8_t BasicSolver<Topology>::getRowAmount() const noexcept {
+        return m_rowAmount;
+    }
+
+    template<typename Topology>
+    inline std::uint8_t BasicSolver<Topology>::getColumnAmount() const noexcept {
+        return m_columnAmount;
+    }
+
+    template<typename Topology>
+    inline std::uint8_t BasicSolver<Topology>::viewAt(const std::uint8_t row,
+                                                      const std::uint8_t column) const noexcept {
+        return m_view[row * m_columnAmount + column];
+    }
+
+    template<typename Topology>
+    inline std::uint8_t BasicSolver<Topology>::viewAt(const std::size_t index) const noexcept {
+        return m_view[index];
+    }
+
+    template<typename Topology>
+    inline bool BasicSolver<Topology>::isOpen(const std::size_t index) const noexcept {
+        return (m_view[index] == hidden) & (m_facts[index] == Fact::unknown);
+    }
+
+    template<typename Topology>
+    inline bool BasicSolver<Topology>::isKnownSafe(const std::uint8_t row, const std::uint8_t column) const noexcept {
+        return m_facts[row * m_columnAmount + column] == Fact::safe;
+    }
+
+    template<typename Topology>
+    inline bool BasicSolver<Topology>::isKnownMine(const std::uint8_t row, const std::uint8_t column) const noexcept {
+        return m_facts[row * m_columnAmount + column] == Fact::mine;
+    }
+
+    template<typename Topology>
+    inline bool BasicSolver<Topology>::isKnownSafe(const std::size_t index) const noexcept {
+        return m_facts[index] == Fact::safe;
+    }
+
+    template<typename Topology>
+    inline bool BasicSolver<Topology>::isKnownMine(const std::size_t index) const noexcept {
+        return m_facts[index] == Fact::mine;
+    }
+
+    template<typename Topology>
+    inline std::span<const std::uint16_t> BasicSolver<Topology>::neighboursOf(const std::size_t index) const noexcept {
+        return {m_neighbours[index].data(), m_neighbourAmounts[index]};
+    }
+
+    template<typename Topology>
+    inline std::size_t BasicSolver<Topology>::getSafeAmount() const noexcept {
+        return m_safeTiles.size();
+    }
+
+    template<typename Topology>
+    inline std::size_t BasicSolver<Topology>::getMineAmount() const noexcept {
+        return m_mineTiles.size();
+    }
+
+    // the tiles settled so far in the order they were, until an unflag withdraws them all
+    template<typename Topology>
+    inline std::span<const std::uint16_t> BasicSolver<Topology>::getSafeTiles() const noexcept {
+        return m_safeTiles;
+    }
+
+    template<typename Topology>
+    inline std::span<const std::uint16_t> BasicSolver<Topology>::getMineTiles() const noexcept {
+        return m_mineTiles;
+    }
+
+    // brings the solver's view up to date with what the board shows, feeding only the tiles that changed
+    template<typename Topology>
+    template<typename Board>
+    void BasicSolver<Topology>::observe(const Board& board) {
+        for (std::uint8_t row{0}; row < m_rowAmount; row++) {
+            for (std::uint8_t column{0}; column < m_columnAmount; column++) {
+                const Tile& tile{board.atCoordinate(row, column)};
+                const std::uint8_t seen{m_view[row * m_columnAmount + column]};
+                if (tile.isChecked()) {
+                    if (seen != tile.getSurroundingMines()) {
+                        reveal(row, column, tile.getSurroundingMines());
+                    }
+                } else if (tile.isFlagged() != (seen == flagged)) {
+                    tile.isFlagged() ? flag(row, column) : unflag(row, column);
+                }
+            }
+        }
+    }
+
+    // the same from the change lists of the moves since the last call, without looking at the rest of the board
+    template<typename Topology>
+    template<typename Board>
+    void BasicSolver<Topology>::observe(const Board& board, const std::span<const TileChange> changes) {
+        for (const TileChange& change: changes) {
+            switch (change.kind) {
+                case ChangeKind::revealed:
+                    reveal(change.row, change.column,
+                           board.atCoordinate(change.row, change.column).getSurroundingMines());
+                    break;
+                case ChangeKind::flagged:
+                    flag(change.row, change.column);
+                    break;
+                case ChangeKind::unflagged:
+                    unflag(change.row, change.column);
+                    break;
+            }
+        }
+    }
+
+    // the tiles deduced safe that are still hidden
+    template<typename Topology>
+    template<typename Function>
+    void BasicSolver<Topology>::forEachSafeTile(Function&& function) const {
+        for (const std::uint16_t index: m_safeTiles) {
+            if (m_view[index] == hidden) {
+                function(static_cast<std::uint8_t>(index / m_columnAmount),
+                         static_cast<std::uint8_t>(index % m_columnAmount));
+            }
+        }
+    }
+
+    template<typename Topology>
+    template<typename Function>
+    void BasicSolver<Topology>::forEachMineTile(Function&& function) const {
+        for (const std::uint16_t index: m_mineTiles) {
+            function(static_cast<std::uint8_t>(index / m_columnAmount),
+                     static_cast<std::uint8_t>(index % m_columnAmount));
+        }
+    }
+} // Minesweeper
+
+#endif //SOLVER_HPP
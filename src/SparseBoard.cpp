@@ -0,0 +1,289 @@
+#include "SparseBoard.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#ifndef _MSC_VER
+#define PCG_RAND
+#include <pcg/pcg_extras.hpp>
+#include <pcg/pcg_random.hpp>
+#endif
+#include <random>
+
+namespace Minesweeper {
+    namespace {
+        // the budget is split between the two planes, and each gets its own spill file next to the given one
+        ChunkStoreOptions planeOptions(const ChunkStoreOptions& options, const char* suffix) {
+            ChunkStoreOptions plane{options.memoryBudget / 2, options.spillFile};
+            if (options.memoryBudget != 0 && plane.memoryBudget == 0) {
+                plane.memoryBudget = 1;
+            }
+            if (!plane.spillFile.empty()) {
+                plane.spillFile += suffix;
+            }
+            return plane;
+        }
+    }
+
+    SparseBoard::SparseBoard(const std::uint32_t rowAmount, const std::uint32_t columnAmount,
+                             const std::uint64_t mineCount, const ChunkStoreOptions& chunkOptions):
+        m_checked{columnAmount, planeOptions(chunkOptions, ".checked")},
+        m_flagged{columnAmount, planeOptions(chunkOptions, ".flagged")},
+        m_rowAmount{rowAmount},
+        m_columnAmount{columnAmount},
+        m_mineCount{mineCount},
+        m_uncheckedSafeAmount{std::uint64_t{rowAmount} * columnAmount - mineCount} {
+        assert(mineCount < std::uint64_t{rowAmount} * columnAmount);
+    }
+
+    std::uint8_t SparseBoard::getSurroundingMines(const std::uint32_t row, const std::uint32_t column) const {
+        // one seek per row of the 3 x 3 box, leaving out the tile itself
+        const std::uint32_t firstRow{row == 0 ? 0 : row - 1};
+        const std::uint32_t lastRow{row + 1 == m_rowAmount ? row : row + 1};
+        const std::uint32_t firstColumn{column == 0 ? 0 : column - 1};
+        const std::uint32_t lastColumn{column + 1 == m_columnAmount ? column : column + 1};
+        const std::uint64_t self{toLinear(row, column)};
+        std::uint8_t mines{0};
+        for (std::uint32_t r{firstRow}; r <= lastRow; r++) {
+            m_mines.forEachInRange(toLinear(r, firstColumn), toLinear(r, lastColumn), [&](const std::uint64_t mine) {
+                mines += mine != self;
+            });
+        }
+        return mines;
+    }
+
+    void SparseBoard::checkTile(const std::uint32_t row, const std::uint32_t column) {
+        if (m_flagged.test(row, column)) {
+            return;
+        }
+        if (m_firstCheck) {
+            generateMines(row, column);
+            m_firstCheck = false;
+        }
+        reveal(row, column);
+    }
+
+    void SparseBoard::toggleFlag(const std::uint32_t row, const std::uint32_t column) {
+        if (m_checked.test(row, column)) {
+            return;
+        }
+        if (!m_flagged.test(row, column)) {
+            m_flagCount++;
+            m_flagged.set(row, column);
+        } else {
+            m_flagCount--;
+            m_flagged.reset(row, column);
+        }
+    }
+
+    void SparseBoard::clearSafeTiles(const std::uint32_t row, const std::uint32_t column) {
+        if (!m_checked.test(row, column)) {
+            return;
+        }
+        const std::uint8_t mines{getSurroundingMines(row, column)};
+        std::uint8_t flagAmount{0};
+        forEachNeighbour(row, column, [&](const std::uint32_t r, const std::uint32_t c) {
+            flagAmount += m_flagged.test(r, c);
+        });
+        if (mines == 0 || flagAmount != mines) {
+            return;
+        }
+        forEachNeighbour(row, column, [&](const std::uint32_t r, const std::uint32_t c) {
+            reveal(r, c);
+        });
+    }
+
+    void SparseBoard::reveal(const std::uint32_t row, const std::uint32_t column) {
+        if (m_checked.test(row, column) || m_flagged.test(row, column)) {
+            return;
+        }
+        if (isMine(row, column)) {
+            m_checked.set(row, column);
+            m_hitMine = true;
+        } else if (getSurroundingMines(row, column) != 0) {
+            m_checked.set(row, column);
+            m_uncheckedSafeAmount--;
+        } else {
+            floodFill(row, column);
+        }
+    }
+
+    void SparseBoard::floodFill(const std::uint32_t row, const std::uint32_t column) {
+        // Opens the zero region around a zero tile a chunk at a time: a chunk takes the tiles seeded into it,
+        // grows them through its own zeros with shifts until nothing changes, and seeds the tiles its newly revealed
+        // zeros touch in the chunks around it. Seeds for the same chunk are merged, so the queue holds chunks.
+        using Chunk = ChunkedBitmap::Chunk;
+        constexpr std::uint32_t side{ChunkedBitmap::chunkSide};
+        const std::uint32_t chunkColumns{(m_columnAmount + side - 1) / side};
+        std::unordered_map<std::uint64_t, Chunk> seeds;
+        std::vector<std::pair<std::uint32_t, std::uint32_t> > pending;
+        auto seed = [&](const std::uint32_t chunkRow, const std::uint32_t chunkColumn, const std::uint32_t chunkLine,
+                        const std::uint64_t bits) {
+            const auto [entry, inserted]{seeds.try_emplace(std::uint64_t{chunkRow} * chunkColumns + chunkColumn)};
+            entry->second[chunkLine] |= bits;
+            if (inserted) {
+                pending.emplace_back(chunkRow, chunkColumn);
+            }
+        };
+        seed(row / side, column / side, row % side, std::uint64_t{1} << column % side);
+        while (!pending.empty()) {
+            const auto [chunkRow, chunkColumn]{pending.back()};
+            pending.pop_back();
+            const auto entry{seeds.find(std::uint64_t{chunkRow} * chunkColumns + chunkColumn)};
+            const Chunk seeded{entry->second};
+            seeds.erase(entry);
+            const Chunk revealed{m_checked.chunkAt(chunkRow, chunkColumn)};
+            const Chunk flagged{m_flagged.chunkAt(chunkRow, chunkColumn)};
+            const Chunk valid{validOf(chunkRow, chunkColumn)};
+            Chunk open{};
+            bool anyNew{false};
+            for (std::uint32_t line{0}; line < side; line++) {
+                open[line] = ~revealed[line] & ~flagged[line] & valid[line];
+                anyNew = anyNew || (seeded[line] & open[line]) != 0;
+            }
+            if (!anyNew) {
+                continue;
+            }
+            const Chunk zeros{zerosOf(chunkRow, chunkColumn)};
+            Chunk fresh{};
+            for (std::uint32_t line{0}; line < side; line++) {
+                fresh[line] = seeded[line] & open[line];
+            }
+            for (bool grew{true}; grew;) {
+                grew = false;
+                for (std::uint32_t line{0}; line < side; line++) {
+                    const std::uint64_t zeroBits{fresh[line] & zeros[line]};
+                    const std::uint64_t dilated{zeroBits | zeroBits << 1 | zeroBits >> 1};
+                    const std::uint32_t lastTarget{std::min(line + 1, side - 1)};
+                    for (std::uint32_t target{line == 0 ? 0 : line - 1}; target <= lastTarget; target++) {
+                        const std::uint64_t added{dilated & open[target] & ~fresh[target]};
+                        fresh[target] |= added;
+                        grew = grew || added != 0;
+                    }
+                }
+            }
+            for (std::uint32_t line{0}; line < side; line++) {
+                m_checked.setBits(chunkRow, chunkColumn, line, fresh[line]);
+                m_uncheckedSafeAmount -= static_cast<std::uint64_t>(std::popcount(fresh[line]));
+                const std::uint64_t zeroBits{fresh[line] & zeros[line]};
+                if (zeroBits == 0) {
+                    continue;
+                }
+                // whatever of the zeros' neighbourhoods lies in another chunk is seeded there
+                const std::uint64_t dilated{zeroBits | zeroBits << 1 | zeroBits >> 1};
+                for (int step{-1}; step <= 1; step++) {
+                    const std::int64_t targetRow{std::int64_t{chunkRow} * side + line + step};
+                    if (targetRow < 0 || targetRow >= m_rowAmount) {
+                        continue;
+                    }
+                    const auto targetChunkRow{static_cast<std::uint32_t>(targetRow / side)};
+                    const auto targetLine{static_cast<std::uint32_t>(targetRow % side)};
+                    if (targetChunkRow != chunkRow) {
+                        seed(targetChunkRow, chunkColumn, targetLine, dilated);
+                    }
+                    if ((zeroBits & 1) != 0 && chunkColumn > 0) {
+                        seed(targetChunkRow, chunkColumn - 1, targetLine, std::uint64_t{1} << 63);
+                    }
+                    if ((zeroBits >> 63) != 0 && chunkColumn + 1 < chunkColumns) {
+                        seed(targetChunkRow, chunkColumn + 1, targetLine, 1);
+                    }
+                }
+            }
+        }
+    }
+
+    ChunkedBitmap::Chunk SparseBoard::zerosOf(const std::uint32_t chunkRow, const std::uint32_t chunkColumn) const {
+        // every mine within one tile of the chunk rules out its 3 x 3 box
+        constexpr std::int64_t side{ChunkedBitmap::chunkSide};
+        const std::int64_t firstRow{chunkRow * side};
+        const std::int64_t firstColumn{chunkColumn * side};
+        const std::int64_t scanFirstColumn{std::max<std::int64_t>(firstColumn - 1, 0)};
+        const std::int64_t scanLastColumn{std::min<std::int64_t>(firstColumn + side, m_columnAmount - 1)};
+        ChunkedBitmap::Chunk nonZero{};
+        auto ruleOut = [&](const std::int64_t mineRow, const std::int64_t mineColumn) {
+            // mineColumn is relative to the chunk and lies in [-1, side]
+            const std::uint64_t box{
+                mineColumn <= 0 ? std::uint64_t{3} >> -mineColumn : std::uint64_t{7} << (mineColumn - 1)
+            };
+            for (std::int64_t line{std::max<std::int64_t>(mineRow - 1, 0)};
+                 line <= std::min<std::int64_t>(mineRow + 1, side - 1); line++) {
+                nonZero[line] |= box;
+            }
+        };
+        const std::int64_t lastMineRow{std::min<std::int64_t>(firstRow + side, m_rowAmount - 1)};
+        for (std::int64_t mineRow{std::max<std::int64_t>(firstRow - 1, 0)}; mineRow <= lastMineRow; mineRow++) {
+            const std::uint64_t rowStart{static_cast<std::uint64_t>(mineRow) * m_columnAmount};
+            m_mines.forEachInRange(rowStart + scanFirstColumn, rowStart + scanLastColumn,
+                                   [&](const std::uint64_t mine) {
+                                       ruleOut(mineRow - firstRow,
+                                               static_cast<std::int64_t>(mine - rowStart) - firstColumn);
+                                   });
+        }
+        ChunkedBitmap::Chunk zeros{};
+        for (std::size_t line{0}; line < side; line++) {
+            zeros[line] = ~nonZero[line];
+        }
+        return zeros;
+    }
+
+    ChunkedBitmap::Chunk SparseBoard::validOf(const std::uint32_t chunkRow,
+                                              const std::uint32_t chunkColumn) const noexcept {
+        // the tiles of the chunk that lie on the board
+        constexpr std::uint32_t side{ChunkedBitmap::chunkSide};
+        const std::uint64_t width{std::min<std::uint64_t>(side, m_columnAmount - std::uint64_t{chunkColumn} * side)};
+        const std::uint64_t columns{width == side ? ~std::uint64_t{0} : (std::uint64_t{1} << width) - 1};
+        ChunkedBitmap::Chunk valid{};
+        for (std::uint32_t line{0}; line < side; line++) {
+            valid[line] = std::uint64_t{chunkRow} * side + line < m_rowAmount ? columns : 0;
+        }
+        return valid;
+    }
+
+    void SparseBoard::generateMines(const std::uint32_t row, const std::uint32_t column) {
+        const std::uint64_t tileAmount{std::uint64_t{m_rowAmount} * m_columnAmount};
+        std::vector<std::uint64_t> safeTiles{toLinear(row, column)};
+        forEachNeighbour(row, column, [&](const std::uint32_t r, const std::uint32_t c) {
+            safeTiles.push_back(toLinear(r, c));
+        });
+        if (m_mineCount >= tileAmount - safeTiles.size()) [[unlikely]] {
+            safeTiles.resize(1);
+        }
+        std::ranges::sort(safeTiles);
+        #ifdef PCG_RAND
+        pcg64_fast rng{
+            m_seed.has_value() ? pcg64_fast{*m_seed} : pcg64_fast{pcg_extras::seed_seq_from<std::random_device>()}
+        };
+        auto randomIndex = [&] { return static_cast<std::uint64_t>(rng(tileAmount)); };
+        #else
+        std::random_device rand;
+        std::seed_seq seedSeq{rand(), rand(), rand(), rand(), rand(), rand(), rand(), rand()};
+        std::mt19937_64 rng{
+            m_seed.has_value() ? std::mt19937_64{*m_seed} : std::mt19937_64{seedSeq}
+        };
+        std::uniform_int_distribution<std::uint64_t> distribution(0, tileAmount - 1);
+        auto randomIndex = [&] { return distribution(rng); };
+        #endif
+        // draws the missing mines, then sorts and drops the duplicates; at the densities this board is meant for
+        // the second round has only a handful of tiles left to draw, and nothing ever holds more than the mines
+        std::vector<std::uint64_t> mines;
+        mines.reserve(m_mineCount);
+        while (mines.size() < m_mineCount) {
+            while (mines.size() < m_mineCount) {
+                const std::uint64_t candidate{randomIndex()};
+                if (!std::ranges::binary_search(safeTiles, candidate)) {
+                    mines.push_back(candidate);
+                }
+            }
+            std::ranges::sort(mines);
+            mines.erase(std::ranges::unique(mines).begin(), mines.end());
+        }
+        m_mines = EliasFano{mines, tileAmount};
+    }
+
+    std::size_t SparseBoard::memoryUsage() const noexcept {
+        return m_mines.memoryUsage() + m_checked.memoryUsage() + m_flagged.memoryUsage();
+    }
+} // Minesweeper
@@ -0,0 +1,141 @@
+#ifndef SPARSEBOARD_HPP
+#define SPARSEBOARD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "ChunkedBitmap.hpp"
+#include "EliasFano.hpp"
+
+
+namespace Minesweeper {
+    // A rectangular board for giant, low-density games (around 0.1 to 1% mines) that never stores a tile array.
+    // The mines are an Elias-Fano set of row-major indices, so a tile's count is a range count over the three
+    // rows around it, a few successor lookups; revealed and flagged tiles are chunked bitmaps that only hold the
+    // explored chunks. Memory therefore follows the mine count plus the explored area, not the board's size.
+    // Openings are flood filled a chunk at a time with word operations, the chunk's zeros found from the handful of
+    // mines around it. Given a memory budget, the chunks beyond it are paged out to disk (see ChunkStore), which keeps
+    // endless sessions on huge boards within a fixed footprint.
+    class SparseBoard final {
+    public:
+        static constexpr std::size_t maxNeighbours{8};
+
+    private:
+        EliasFano m_mines;
+        ChunkedBitmap m_checked;
+        ChunkedBitmap m_flagged;
+        const std::uint32_t m_rowAmount;
+        const std::uint32_t m_columnAmount;
+        const std::uint64_t m_mineCount;
+        std::uint64_t m_uncheckedSafeAmount;
+        std::uint64_t m_flagCount{0};
+        std::optional<std::uint64_t> m_seed{};
+        bool m_firstCheck{true};
+        bool m_hitMine{false};
+
+        template<typename Function>
+        void forEachNeighbour(std::uint32_t row, std::uint32_t column, Function&& function) const;
+        void generateMines(std::uint32_t row, std::uint32_t column);
+        void reveal(std::uint32_t row, std::uint32_t column);
+        void floodFill(std::uint32_t row, std::uint32_t column);
+        [[nodiscard]] ChunkedBitmap::Chunk zerosOf(std::uint32_t chunkRow, std::uint32_t chunkColumn) const;
+        [[nodiscard]] ChunkedBitmap::Chunk validOf(std::uint32_t chunkRow, std::uint32_t chunkColumn) const noexcept;
+        [[nodiscard]] std::uint64_t toLinear(std::uint32_t row, std::uint32_t column) const noexcept;
+
+    public:
+        explicit SparseBoard(std::uint32_t rowAmount, std::uint32_t columnAmount, std::uint64_t mineCount,
+                             const ChunkStoreOptions& chunkOptions = {});
+        [[nodiscard]] std::uint32_t getRowAmount() const noexcept;
+        [[nodiscard]] std::uint32_t getColumnAmount() const noexcept;
+        [[nodiscard]] std::uint64_t getMineCount() const noexcept;
+        [[nodiscard]] std::int64_t getRemainingMines() const noexcept;
+        [[nodiscard]] std::uint64_t getCheckedAmount() const noexcept;
+        [[nodiscard]] bool foundAllMines() const noexcept;
+        [[nodiscard]] bool hitMine() const noexcept;
+        [[nodiscard]] bool isChecked(std::uint32_t row, std::uint32_t column) const;
+        [[nodiscard]] bool isFlagged(std::uint32_t row, std::uint32_t column) const;
+        [[nodiscard]] bool isMine(std::uint32_t row, std::uint32_t column) const;
+        [[nodiscard]] std::uint8_t getSurroundingMines(std::uint32_t row, std::uint32_t column) const;
+        void checkTile(std::uint32_t row, std::uint32_t column);
+        void toggleFlag(std::uint32_t row, std::uint32_t column);
+        void clearSafeTiles(std::uint32_t row, std::uint32_t column);
+        void setSeed(std::uint64_t seed) noexcept;
+        [[nodiscard]] std::size_t memoryUsage() const noexcept;
+        [[nodiscard]] const ChunkStore& getCheckedChunks() const noexcept;
+        [[nodiscard]] const ChunkStore& getFlaggedChunks() const noexcept;
+    };
+
+    inline std::uint32_t SparseBoard::getRowAmount() const noexcept {
+        return m_rowAmount;
+    }
+
+    inline std::uint32_t SparseBoard::getColumnAmount() const noexcept {
+        return m_columnAmount;
+    }
+
+    inline std::uint64_t SparseBoard::getMineCount() const noexcept {
+        return m_mineCount;
+    }
+
+    inline std::int64_t SparseBoard::getRemainingMines() const noexcept {
+        return static_cast<std::int64_t>(m_mineCount) - static_cast<std::int64_t>(m_flagCount);
+    }
+
+    inline std::uint64_t SparseBoard::getCheckedAmount() const noexcept {
+        return m_checked.count();
+    }
+
+    inline bool SparseBoard::foundAllMines() const noexcept {
+        return m_uncheckedSafeAmount == 0 && !m_hitMine;
+    }
+
+    inline bool SparseBoard::hitMine() const noexcept {
+        return m_hitMine;
+    }
+
+    inline bool SparseBoard::isChecked(const std::uint32_t row, const std::uint32_t column) const {
+        return m_checked.test(row, column);
+    }
+
+    inline bool SparseBoard::isFlagged(const std::uint32_t row, const std::uint32_t column) const {
+        return m_flagged.test(row, column);
+    }
+
+    inline bool SparseBoard::isMine(const std::uint32_t row, const std::uint32_t column) const {
+        return m_mines.contains(toLinear(row, column));
+    }
+
+    inline const ChunkStore& SparseBoard::getCheckedChunks() const noexcept {
+        return m_checked.getStore();
+    }
+
+    inline const ChunkStore& SparseBoard::getFlaggedChunks() const noexcept {
+        return m_flagged.getStore();
+    }
+
+    inline void SparseBoard::setSeed(const std::uint64_t seed) noexcept {
+        m_seed = seed;
+    }
+
+    inline std::uint64_t SparseBoard::toLinear(const std::uint32_t row, const std::uint32_t column) const noexcept {
+        return std::uint64_t{row} * m_columnAmount + column;
+    }
+
+    template<typename Function>
+    void SparseBoard::forEachNeighbour(const std::uint32_t row, const std::uint32_t column, Function&& function) const {
+        const std::uint32_t firstRow{row == 0 ? 0 : row - 1};
+        const std::uint32_t lastRow{row + 1 == m_rowAmount ? row : row + 1};
+        const std::uint32_t firstColumn{column == 0 ? 0 : column - 1};
+        const std::uint32_t lastColumn{column + 1 == m_columnAmount ? column : column + 1};
+        for (std::uint32_t r{firstRow}; r <= lastRow; r++) {
+            for (std::uint32_t c{firstColumn}; c <= lastColumn; c++) {
+                if (r != row || c != column) {
+                    function(r, c);
+                }
+            }
+        }
+    }
+} // Minesweeper
+
+#endif //SPARSEBOARD_HPP
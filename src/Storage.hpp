@@ -0,0 +1,101 @@
+#ifndef STORAGE_HPP
+#define STORAGE_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+#include "Layout.hpp"
+#include "Tile.hpp"
+
+namespace Minesweeper {
+    // A storage owns a board's tiles and places them according to its layout. Boards take one as a template
+    // parameter: VectorStorage sizes itself when the board is built, FixedStorage has its extents in the type and
+    // keeps the tiles inline, so a board of a known size needs no allocation for them.
+
+    template<typename TileLayout = RowMajorLayout>
+    class VectorStorage final {
+        std::vector<Tile> m_tiles;
+
+    public:
+        using Layout = TileLayout;
+
+        explicit VectorStorage(std::uint8_t rowAmount, std::uint8_t columnAmount);
+        [[nodiscard]] Tile& operator[](std::size_t position) noexcept;
+        [[nodiscard]] const Tile& operator[](std::size_t position) const noexcept;
+        [[nodiscard]] std::size_t size() const noexcept;
+    };
+
+    template<std::uint8_t Rows, std::uint8_t Columns, typename TileLayout = RowMajorLayout>
+    class FixedStorage final {
+        static constexpr std::size_t capacity{TileLayout::storageSize(Rows, Columns)};
+
+        // Tile has no default constructor, so the tiles are constructed in place in raw storage
+        alignas(Tile) std::byte m_tiles[capacity * sizeof(Tile)];
+
+    public:
+        using Layout = TileLayout;
+
+        explicit FixedStorage(std::uint8_t rowAmount, std::uint8_t columnAmount) noexcept;
+        FixedStorage(const FixedStorage&) = delete;
+        FixedStorage& operator=(const FixedStorage&) = delete;
+        [[nodiscard]] Tile& operator[](std::size_t position) noexcept;
+        [[nodiscard]] const Tile& operator[](std::size_t position) const noexcept;
+        [[nodiscard]] static constexpr std::size_t size() noexcept;
+    };
+
+    template<typename TileLayout>
+    VectorStorage<TileLayout>::VectorStorage(const std::uint8_t rowAmount, const std::uint8_t columnAmount) {
+        const std::size_t storageSize{Layout::storageSize(rowAmount, columnAmount)};
+        m_tiles.reserve(storageSize);
+        for (std::size_t position{0}; position < storageSize; position++) {
+            // padding slots of blocked layouts get coordinates past the edge and are never reached
+            const auto [row, col]{Layout::fromStorage(columnAmount, position)};
+            m_tiles.emplace_back(static_cast<std::uint8_t>(row), static_cast<std::uint8_t>(col));
+        }
+    }
+
+    template<typename TileLayout>
+    inline Tile& VectorStorage<TileLayout>::operator[](const std::size_t position) noexcept {
+        return m_tiles[position];
+    }
+
+    template<typename TileLayout>
+    inline const Tile& VectorStorage<TileLayout>::operator[](const std::size_t position) const noexcept {
+        return m_tiles[position];
+    }
+
+    template<typename TileLayout>
+    inline std::size_t VectorStorage<TileLayout>::size() const noexcept {
+        return m_tiles.size();
+    }
+
+    template<std::uint8_t Rows, std::uint8_t Columns, typename TileLayout>
+    FixedStorage<Rows, Columns, TileLayout>::FixedStorage(const std::uint8_t rowAmount,
+                                                          const std::uint8_t columnAmount) noexcept {
+        assert(rowAmount == Rows && columnAmount == Columns);
+        for (std::size_t position{0}; position < capacity; position++) {
+            const auto [row, col]{Layout::fromStorage(Columns, position)};
+            new(m_tiles + position * sizeof(Tile)) Tile{static_cast<std::uint8_t>(row), static_cast<std::uint8_t>(col)};
+        }
+    }
+
+    template<std::uint8_t Rows, std::uint8_t Columns, typename TileLayout>
+    inline Tile& FixedStorage<Rows, Columns, TileLayout>::operator[](const std::size_t position) noexcept {
+        return *std::launder(reinterpret_cast<Tile*>(m_tiles + position * sizeof(Tile)));
+    }
+
+    template<std::uint8_t Rows, std::uint8_t Columns, typename TileLayout>
+    inline const Tile& FixedStorage<Rows, Columns, TileLayout>::operator[](const std::size_t position) const noexcept {
+        return *std::launder(reinterpret_cast<const Tile*>(m_tiles + position * sizeof(Tile)));
+    }
+
+    template<std::uint8_t Rows, std::uint8_t Columns, typename TileLayout>
+    constexpr std::size_t FixedStorage<Rows, Columns, TileLayout>::size() noexcept {
+        return capacity;
+    }
+} // Minesweeper
+
+#endif //STORAGE_HPP
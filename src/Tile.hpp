@@ -11,6 +11,7 @@ namespace Minesweeper {
         bool m_isChecked : 1 {false};
         bool m_isFlagged : 1 {false};
         bool m_isMine : 1 {false};
+        bool m_isCounted : 1 {false};
 
     public:
         explicit Tile(std::uint8_t row, std::uint8_t column) noexcept;
@@ -21,10 +22,13 @@ namespace Minesweeper {
         [[nodiscard]] bool isChecked() const noexcept;
         [[nodiscard]] bool isFlagged() const noexcept;
         [[nodiscard]] bool isMine() const noexcept;
+        [[nodiscard]] bool isCounted() const noexcept;
         void incrementSurroundingMines() noexcept;
+        void setSurroundingMines(std::uint8_t surroundingMines) noexcept;
         void becomeChecked() noexcept;
         void becomeMine() noexcept;
         void toggleFlag() noexcept;
+        void reset() noexcept;
     };
 
     inline Tile::Tile(const std::uint8_t row, const std::uint8_t column) noexcept: m_row(row), m_column(column) { }
@@ -53,6 +57,10 @@ namespace Minesweeper {
         return m_isMine;
     }
 
+    inline bool Tile::isCounted() const noexcept {
+        return m_isCounted;
+    }
+
     inline void Tile::incrementSurroundingMines() noexcept {
         if (m_surroundingMines + 1 >= 9) {
             return;
@@ -60,6 +68,11 @@ namespace Minesweeper {
         m_surroundingMines++;
     }
 
+    inline void Tile::setSurroundingMines(const std::uint8_t surroundingMines) noexcept {
+        m_surroundingMines = surroundingMines < 9 ? surroundingMines : 8;
+        m_isCounted = true;
+    }
+
     inline void Tile::becomeChecked() noexcept {
         if (m_isFlagged) {
             return;
@@ -80,6 +93,15 @@ namespace Minesweeper {
         }
         m_isFlagged = !m_isFlagged;
     }
+
+    // back to a closed, unflagged, uncounted tile; the coordinates stay
+    inline void Tile::reset() noexcept {
+        m_surroundingMines = 0;
+        m_isChecked = false;
+        m_isFlagged = false;
+        m_isMine = false;
+        m_isCounted = false;
+    }
 } // Minesweeper
 
 #endif //TILE_HPP
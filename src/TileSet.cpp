@@ -0,0 +1,9 @@
+#include "TileSet.hpp"
+
+namespace Minesweeper {
+    TileSet::TileSet(const std::size_t tileAmount):
+        m_words((tileAmount + 63) / 64, 0),
+        m_positions(tileAmount, 0) {
+        m_tiles.reserve(tileAmount);
+    }
+} // Minesweeper
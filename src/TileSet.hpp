@@ -0,0 +1,88 @@
+#ifndef TILESET_HPP
+#define TILESET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+
+namespace Minesweeper {
+    // A set of tile indices kept twice: as a bitmap, for membership tests and word-at-a-time work, and as a dense
+    // list, so iterating the members costs nothing per tile outside the set. Each member remembers its place in the
+    // list and an erase moves the last member into the gap, which makes both updates O(1) and the order arbitrary.
+    class TileSet final {
+        std::vector<std::uint64_t> m_words;
+        std::vector<std::uint16_t> m_tiles;
+        std::vector<std::uint16_t> m_positions; // of each member in m_tiles, stale for the rest
+
+    public:
+        explicit TileSet(std::size_t tileAmount = 0);
+        [[nodiscard]] bool contains(std::size_t index) const noexcept;
+        bool insert(std::size_t index) noexcept;
+        bool erase(std::size_t index) noexcept;
+        void clear() noexcept;
+        [[nodiscard]] std::size_t size() const noexcept;
+        [[nodiscard]] bool empty() const noexcept;
+        [[nodiscard]] std::span<const std::uint16_t> tiles() const noexcept;
+        [[nodiscard]] std::span<const std::uint64_t> words() const noexcept;
+    };
+
+    inline bool TileSet::contains(const std::size_t index) const noexcept {
+        return m_words[index / 64] >> (index % 64) & 1;
+    }
+
+    // false if the tile was already in the set
+    inline bool TileSet::insert(const std::size_t index) noexcept {
+        std::uint64_t& word{m_words[index / 64]};
+        const std::uint64_t mask{std::uint64_t{1} << (index % 64)};
+        if ((word & mask) != 0) {
+            return false;
+        }
+        word |= mask;
+        m_positions[index] = static_cast<std::uint16_t>(m_tiles.size());
+        m_tiles.push_back(static_cast<std::uint16_t>(index));
+        return true;
+    }
+
+    // false if the tile was not in the set
+    inline bool TileSet::erase(const std::size_t index) noexcept {
+        std::uint64_t& word{m_words[index / 64]};
+        const std::uint64_t mask{std::uint64_t{1} << (index % 64)};
+        if ((word & mask) == 0) {
+            return false;
+        }
+        word &= ~mask;
+        const std::uint16_t last{m_tiles.back()};
+        m_tiles[m_positions[index]] = last;
+        m_positions[last] = m_positions[index];
+        m_tiles.pop_back();
+        return true;
+    }
+
+    // touches only the members, so it costs nothing for a set that is already small
+    inline void TileSet::clear() noexcept {
+        for (const std::uint16_t index: m_tiles) {
+            m_words[index / 64] = 0;
+        }
+        m_tiles.clear();
+    }
+
+    inline std::size_t TileSet::size() const noexcept {
+        return m_tiles.size();
+    }
+
+    inline bool TileSet::empty() const noexcept {
+        return m_tiles.empty();
+    }
+
+    inline std::span<const std::uint16_t> TileSet::tiles() const noexcept {
+        return m_tiles;
+    }
+
+    inline std::span<const std::uint64_t> TileSet::words() const noexcept {
+        return m_words;
+    }
+} // Minesweeper
+
+#endif //TILESET_HPP
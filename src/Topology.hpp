@@ -0,0 +1,168 @@
+#ifndef TOPOLOGY_HPP
+#define TOPOLOGY_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace Minesweeper {
+    // A topology decides which tiles neighbour each other. Boards take one as a template parameter, so the
+    // neighbourhood loop is resolved and inlined at compile time rather than dispatched per tile. forEachOffset
+    // gives the same neighbourhood as (row, column) steps from any tile of a row, ignoring the board's edges, for
+    // code that shifts whole rows at once; wraps says whether steps over an edge come back on the other side.
+
+    struct RectangularTopology {
+        static constexpr std::size_t maxNeighbours{8};
+        static constexpr bool wraps{false};
+
+        template<typename Function>
+        static constexpr void forEachNeighbour(std::uint8_t rowAmount, std::uint8_t columnAmount,
+                                               std::uint8_t row, std::uint8_t column, Function&& function);
+        template<typename Function>
+        static constexpr void forEachOffset(std::uint8_t row, Function&& function);
+    };
+
+    struct TorusTopology {
+        static constexpr std::size_t maxNeighbours{8};
+        static constexpr bool wraps{true};
+
+        template<typename Function>
+        static constexpr void forEachNeighbour(std::uint8_t rowAmount, std::uint8_t columnAmount,
+                                               std::uint8_t row, std::uint8_t column, Function&& function);
+        template<typename Function>
+        static constexpr void forEachOffset(std::uint8_t row, Function&& function);
+    };
+
+    // hexagonal tiles in "odd-r" offset coordinates: odd rows are shifted half a tile to the right
+    struct HexagonalTopology {
+        static constexpr std::size_t maxNeighbours{6};
+        static constexpr bool wraps{false};
+
+        template<typename Function>
+        static constexpr void forEachNeighbour(std::uint8_t rowAmount, std::uint8_t columnAmount,
+                                               std::uint8_t row, std::uint8_t column, Function&& function);
+        template<typename Function>
+        static constexpr void forEachOffset(std::uint8_t row, Function&& function);
+    };
+
+    struct KnightTopology {
+        static constexpr std::size_t maxNeighbours{8};
+        static constexpr bool wraps{false};
+
+        template<typename Function>
+        static constexpr void forEachNeighbour(std::uint8_t rowAmount, std::uint8_t columnAmount,
+                                               std::uint8_t row, std::uint8_t column, Function&& function);
+        template<typename Function>
+        static constexpr void forEachOffset(std::uint8_t row, Function&& function);
+    };
+
+    namespace detail {
+        constexpr std::array<std::pair<std::int_fast8_t, std::int_fast8_t>, 8> boxOffsets{
+            {{-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}, {1, 1}}
+        };
+        constexpr std::array<std::pair<std::int_fast8_t, std::int_fast8_t>, 6> evenRowHexOffsets{
+            {{-1, -1}, {-1, 0}, {0, -1}, {0, 1}, {1, -1}, {1, 0}}
+        };
+        constexpr std::array<std::pair<std::int_fast8_t, std::int_fast8_t>, 6> oddRowHexOffsets{
+            {{-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, 0}, {1, 1}}
+        };
+        constexpr std::array<std::pair<std::int_fast8_t, std::int_fast8_t>, 8> knightOffsets{
+            {{-2, -1}, {-2, 1}, {-1, -2}, {-1, 2}, {1, -2}, {1, 2}, {2, -1}, {2, 1}}
+        };
+
+        template<std::size_t N, typename Function>
+        constexpr void forEachClippedOffset(const std::array<std::pair<std::int_fast8_t, std::int_fast8_t>, N>& offsets,
+                                            const std::uint8_t rowAmount, const std::uint8_t columnAmount,
+                                            const std::uint8_t row, const std::uint8_t column, Function&& function) {
+            for (const auto& [r, c]: offsets) {
+                if (r + row < 0 || r + row >= rowAmount || c + column < 0 || c + column >= columnAmount) {
+                    continue;
+                }
+                function(static_cast<std::uint8_t>(row + r), static_cast<std::uint8_t>(column + c));
+            }
+        }
+    }
+
+    template<typename Function>
+    constexpr void RectangularTopology::forEachNeighbour(const std::uint8_t rowAmount, const std::uint8_t columnAmount,
+                                                         const std::uint8_t row, const std::uint8_t column,
+                                                         Function&& function) {
+        for (std::int_fast8_t r{-1}; r <= 1; r++) {
+            if (r + row < 0 || r + row >= rowAmount) {
+                continue;
+            }
+            for (std::int_fast8_t c{-1}; c <= 1; c++) {
+                if (c + column < 0 || c + column >= columnAmount || (c == 0 && r == 0)) {
+                    continue;
+                }
+                function(static_cast<std::uint8_t>(row + r), static_cast<std::uint8_t>(column + c));
+            }
+        }
+    }
+
+    template<typename Function>
+    constexpr void TorusTopology::forEachNeighbour(const std::uint8_t rowAmount, const std::uint8_t columnAmount,
+                                                   const std::uint8_t row, const std::uint8_t column,
+                                                   Function&& function) {
+        // assumes at least 3 rows and columns, otherwise wrapping would visit a tile twice
+        const std::uint8_t up{static_cast<std::uint8_t>(row == 0 ? rowAmount - 1 : row - 1)};
+        const std::uint8_t down{static_cast<std::uint8_t>(row + 1 == rowAmount ? 0 : row + 1)};
+        const std::uint8_t left{static_cast<std::uint8_t>(column == 0 ? columnAmount - 1 : column - 1)};
+        const std::uint8_t right{static_cast<std::uint8_t>(column + 1 == columnAmount ? 0 : column + 1)};
+        function(up, left);
+        function(up, column);
+        function(up, right);
+        function(row, left);
+        function(row, right);
+        function(down, left);
+        function(down, column);
+        function(down, right);
+    }
+
+    template<typename Function>
+    constexpr void HexagonalTopology::forEachNeighbour(const std::uint8_t rowAmount, const std::uint8_t columnAmount,
+                                                       const std::uint8_t row, const std::uint8_t column,
+                                                       Function&& function) {
+        detail::forEachClippedOffset(row % 2 == 0 ? detail::evenRowHexOffsets : detail::oddRowHexOffsets, rowAmount,
+                                     columnAmount, row, column, std::forward<Function>(function));
+    }
+
+    template<typename Function>
+    constexpr void KnightTopology::forEachNeighbour(const std::uint8_t rowAmount, const std::uint8_t columnAmount,
+                                                    const std::uint8_t row, const std::uint8_t column,
+                                                    Function&& function) {
+        detail::forEachClippedOffset(detail::knightOffsets, rowAmount, columnAmount, row, column,
+                                     std::forward<Function>(function));
+    }
+
+    template<typename Function>
+    constexpr void RectangularTopology::forEachOffset(std::uint8_t, Function&& function) {
+        for (const auto& [r, c]: detail::boxOffsets) {
+            function(r, c);
+        }
+    }
+
+    template<typename Function>
+    constexpr void TorusTopology::forEachOffset(std::uint8_t, Function&& function) {
+        for (const auto& [r, c]: detail::boxOffsets) {
+            function(r, c);
+        }
+    }
+
+    template<typename Function>
+    constexpr void HexagonalTopology::forEachOffset(const std::uint8_t row, Function&& function) {
+        for (const auto& [r, c]: row % 2 == 0 ? detail::evenRowHexOffsets : detail::oddRowHexOffsets) {
+            function(r, c);
+        }
+    }
+
+    template<typename Function>
+    constexpr void KnightTopology::forEachOffset(std::uint8_t, Function&& function) {
+        for (const auto& [r, c]: detail::knightOffsets) {
+            function(r, c);
+        }
+    }
+} // Minesweeper
+
+#endif //TOPOLOGY_HPP
@@ -0,0 +1,96 @@
+#include "TranspositionTable.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+namespace Minesweeper {
+    namespace {
+        // the first and one past the last mine count with any arrangement
+        [[nodiscard]] std::pair<std::size_t, std::size_t> support(const std::span<const double> counts) noexcept {
+            std::size_t first{0};
+            std::size_t end{counts.size()};
+            while (first < end && counts[first] == 0.0) {
+                first++;
+            }
+            while (end > first && counts[end - 1] == 0.0) {
+                end--;
+            }
+            return {first, end};
+        }
+    }
+
+    // the slot amount is rounded up to a power of two, so a key picks its slot with a mask
+    TranspositionTable::TranspositionTable(const std::size_t slotAmount):
+        m_slotAmount{std::bit_ceil(std::max<std::size_t>(slotAmount, 1))} {
+        m_words = std::make_unique<std::atomic<std::uint64_t>[]>(m_slotAmount * slotWords);
+    }
+
+    // Copies the tallies of the component with this key into arrangements (one count per mine amount, tiles + 1 of
+    // them) and groupMines (a row like it per group), provided they were counted up to at least mineLimit mines or
+    // the whole component. Returns the mine limit they were counted with, or nothing on a miss.
+    std::optional<std::size_t> TranspositionTable::load(const std::uint64_t key, const std::size_t mineLimit,
+                                                        const std::span<double> arrangements,
+                                                        const std::span<double> groupMines) const noexcept {
+        const std::atomic<std::uint64_t>* slot{&m_words[(key & (m_slotAmount - 1)) * slotWords]};
+        const std::uint64_t sequence{slot[0].load(std::memory_order_acquire)};
+        if (sequence % 2 == 1 || slot[1].load(std::memory_order_relaxed) != key) {
+            return std::nullopt;
+        }
+        const std::uint64_t shape{slot[2].load(std::memory_order_relaxed)};
+        const std::uint64_t range{slot[3].load(std::memory_order_relaxed)};
+        const std::size_t width{arrangements.size()};
+        const std::size_t storedLimit{shape >> 32};
+        const std::size_t first{range & 0xFFFFFFFF};
+        const std::size_t end{range >> 32};
+        if ((shape & 0xFFFFFFFF) != width || storedLimit < std::min(mineLimit, width - 1) || end > width ||
+            first > end || (groupMines.size() / width + 1) * (end - first) > payloadWords) {
+            return std::nullopt;
+        }
+        std::ranges::fill(arrangements, 0.0);
+        std::ranges::fill(groupMines, 0.0);
+        std::size_t word{headerWords};
+        for (std::size_t row{0}; row * width < groupMines.size() + width; row++) {
+            const std::span<double> counts{row == 0 ? arrangements : groupMines.subspan((row - 1) * width, width)};
+            for (std::size_t mines{first}; mines < end; mines++) {
+                counts[mines] = std::bit_cast<double>(slot[word++].load(std::memory_order_relaxed));
+            }
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot[0].load(std::memory_order_relaxed) != sequence) {
+            return std::nullopt;
+        }
+        return storedLimit;
+    }
+
+    // keeps the tallies of a component counted up to mineLimit mines, laid out as load() hands them back
+    void TranspositionTable::store(const std::uint64_t key, const std::size_t mineLimit,
+                                   const std::span<const double> arrangements,
+                                   const std::span<const double> groupMines) noexcept {
+        const std::size_t width{arrangements.size()};
+        const auto [first, end]{support(arrangements)};
+        if ((groupMines.size() / width + 1) * (end - first) > payloadWords) {
+            return;
+        }
+        std::atomic<std::uint64_t>* slot{&m_words[(key & (m_slotAmount - 1)) * slotWords]};
+        std::uint64_t sequence{slot[0].load(std::memory_order_relaxed)};
+        if (sequence % 2 == 1 || !slot[0].compare_exchange_strong(sequence, sequence + 1, std::memory_order_relaxed)) {
+            return;
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+        slot[1].store(key, std::memory_order_relaxed);
+        slot[2].store(width | std::uint64_t{std::min<std::size_t>(mineLimit, 0xFFFFFFFF)} << 32,
+                      std::memory_order_relaxed);
+        slot[3].store(first | std::uint64_t{end} << 32, std::memory_order_relaxed);
+        std::size_t word{headerWords};
+        for (std::size_t row{0}; row * width < groupMines.size() + width; row++) {
+            const std::span<const double> counts{
+                row == 0 ? arrangements : groupMines.subspan((row - 1) * width, width)
+            };
+            for (std::size_t mines{first}; mines < end; mines++) {
+                slot[word++].store(std::bit_cast<std::uint64_t>(counts[mines]), std::memory_order_relaxed);
+            }
+        }
+        slot[0].store(sequence + 2, std::memory_order_release);
+    }
+} // Minesweeper
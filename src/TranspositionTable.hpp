@@ -0,0 +1,51 @@
+#ifndef TRANSPOSITIONTABLE_HPP
+#define TRANSPOSITIONTABLE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+
+
+namespace Minesweeper {
+    // A fixed-size cache of frontier component tallies, keyed by the component's Zobrist hash and shared by any
+    // number of probability solvers on any number of threads without a lock. Every slot is a sequence lock: a writer
+    // claims the slot by making its sequence odd, fills it and makes it even again, and a reader copies the slot and
+    // only trusts the copy if the sequence was the same even number before and after. A writer that finds a slot
+    // busy skips the store and a reader that races one misses, so nobody ever waits. The newest store of a slot
+    // wins. Only the mine counts a component can actually take are stored, for the total and for each group, and
+    // tallies too large for a slot are not cached at all.
+    class TranspositionTable final {
+    public:
+        static constexpr std::size_t payloadWords{512};
+
+    private:
+        static constexpr std::size_t headerWords{4}; // sequence, key, shape, support
+        static constexpr std::size_t slotWords{headerWords + payloadWords};
+
+        std::unique_ptr<std::atomic<std::uint64_t>[]> m_words;
+        std::size_t m_slotAmount;
+
+    public:
+        explicit TranspositionTable(std::size_t slotAmount = 2048);
+        [[nodiscard]] std::optional<std::size_t> load(std::uint64_t key, std::size_t mineLimit,
+                                                      std::span<double> arrangements,
+                                                      std::span<double> groupMines) const noexcept;
+        void store(std::uint64_t key, std::size_t mineLimit, std::span<const double> arrangements,
+                   std::span<const double> groupMines) noexcept;
+        [[nodiscard]] std::size_t getSlotAmount() const noexcept;
+        [[nodiscard]] std::size_t memoryUsage() const noexcept;
+    };
+
+    inline std::size_t TranspositionTable::getSlotAmount() const noexcept {
+        return m_slotAmount;
+    }
+
+    inline std::size_t TranspositionTable::memoryUsage() const noexcept {
+        return m_slotAmount * slotWords * sizeof(std::atomic<std::uint64_t>);
+    }
+} // Minesweeper
+
+#endif //TRANSPOSITIONTABLE_HPP
@@ -1,11 +1,17 @@
 #include <chrono>
 #include <cstdint>
+#include <optional>
+#include <ranges>
 #include <thread>
 #include <argparse/argparse.hpp>
 #include <ftxui/component/screen_interactive.hpp>
 
 #include "Board.hpp"
 #include "BoardComponentBase.hpp"
+#include "HugePageAllocator.hpp"
+#include "NdBoard.hpp"
+#include "Simulation.hpp"
+#include "SliceComponentBase.hpp"
 
 #if defined(_MSVC_VER) && !defined(__clang__)
 #define UNREACHABLE() __assume(false)
@@ -16,22 +22,49 @@
 #define UNREACHABLE() unreachable()
 #endif
 
-void customInitialization(ftxui::ScreenInteractive& screen, std::shared_ptr<Minesweeper::Board>& board);
+// what --simulate asked for: games played by the solver on a board of the given difficulty, with no TUI
+struct SimulationSettings {
+    std::size_t games;
+    std::string difficulty;
+    std::uint8_t rowAmount;
+    std::uint8_t columnAmount;
+    std::uint16_t mineCount;
+    std::size_t threadAmount;
+};
 
-void parseArguments(int argc, const char* const argv[], std::shared_ptr<Minesweeper::Board>& board);
+void customInitialization(ftxui::ScreenInteractive& screen, std::shared_ptr<Minesweeper::Board>& board,
+                          Minesweeper::CountMode countMode, Minesweeper::RevealEngine revealEngine);
+
+void parseArguments(int argc, const char* const argv[], std::shared_ptr<Minesweeper::Board>& board,
+                    std::shared_ptr<Minesweeper::VolumeBoard>& volume, Minesweeper::CountMode& countMode,
+                    Minesweeper::RevealEngine& revealEngine, std::optional<SimulationSettings>& simulation);
+
+int simulate(const SimulationSettings& settings);
+
+int playVolume(ftxui::ScreenInteractive& screen, std::shared_ptr<Minesweeper::VolumeBoard>& volume);
 
 int main(const int argc, const char* const argv[]) {
     using Minesweeper::Board, Minesweeper::BoardComponentBase, Minesweeper::BoardComponent;
     namespace tui = ftxui;
     std::shared_ptr<Board> board{nullptr};
+    std::shared_ptr<Minesweeper::VolumeBoard> volume{nullptr};
+    Minesweeper::CountMode countMode{Minesweeper::CountMode::eager};
+    Minesweeper::RevealEngine revealEngine{Minesweeper::RevealEngine::threaded};
+    std::optional<SimulationSettings> simulation{};
     try {
-        parseArguments(argc, argv, board);
+        parseArguments(argc, argv, board, volume, countMode, revealEngine, simulation);
     } catch (...) {
         return EXIT_FAILURE;
     }
+    if (simulation) {
+        return simulate(*simulation);
+    }
     try {
         tui::ScreenInteractive screen{tui::ScreenInteractive::Fullscreen()};
         screen.SetCursor({0, 0, tui::Screen::Cursor::Shape::Hidden});
+        if (volume != nullptr) {
+            return playVolume(screen, volume);
+        }
         while (true) {
             if (board == nullptr) {
                 int difficultySelection{-1};
@@ -57,23 +90,27 @@ int main(const int argc, const char* const argv[]) {
                 };
                 switch (static_cast<Difficulty>(difficultySelection)) {
                     case Difficulty::beginner:
-                        board = std::make_shared<Board>(9, 9, 10);
+                        board = std::make_shared<Board>(9, 9, 10, countMode, revealEngine);
                         break;
                     case Difficulty::intermediate:
-                        board = std::make_shared<Board>(16, 16, 40);
+                        board = std::make_shared<Board>(16, 16, 40, countMode, revealEngine);
                         break;
                     case Difficulty::expert:
-                        board = std::make_shared<Board>(16, 30, 99);
+                        board = std::make_shared<Board>(16, 30, 99, countMode, revealEngine);
                         break;
                     case Difficulty::custom:
-                        customInitialization(screen, board);
+                        customInitialization(screen, board, countMode, revealEngine);
                         break;
                     [[unlikely]] default:
                         throw std::out_of_range("Difficulty selection out of range");
                 }
             }
 
-            const BoardComponent baseBoard{BoardComponentBase::Create(board, screen.ExitLoopClosure())};
+            const BoardComponent baseBoard{
+                BoardComponentBase::Create(board, screen.ExitLoopClosure(), [&screen] {
+                    screen.PostEvent(tui::Event::Custom);
+                })
+            };
             const tui::Component boardComponent{Hoverable(baseBoard, &baseBoard->hovered)};
             const tui::Component boardRenderer = Renderer(boardComponent, [&] {
                 return boardComponent->Render() | tui::border;
@@ -186,7 +223,8 @@ int main(const int argc, const char* const argv[]) {
     }
 }
 
-void customInitialization(ftxui::ScreenInteractive& screen, std::shared_ptr<Minesweeper::Board>& board) {
+void customInitialization(ftxui::ScreenInteractive& screen, std::shared_ptr<Minesweeper::Board>& board,
+                          const Minesweeper::CountMode countMode, const Minesweeper::RevealEngine revealEngine) {
     std::string rowStr, columnStr, mineStr;
     std::uint8_t row, column;
     std::uint16_t mines;
@@ -258,10 +296,61 @@ void customInitialization(ftxui::ScreenInteractive& screen, std::shared_ptr<Mine
     const ftxui::Component customMenu{ftxui::Container::Vertical({customInputs, customButton})};
     screen.Loop(customMenu | ftxui::border | ftxui::center);
     screen.SetCursor({0, 0, ftxui::Screen::Cursor::Shape::Hidden});
-    board = std::make_shared<Minesweeper::Board>(row, column, mines);
+    board = std::make_shared<Minesweeper::Board>(row, column, mines, countMode, revealEngine);
 }
 
-void parseArguments(const int argc, const char* const argv[], std::shared_ptr<Minesweeper::Board>& board) {
+int playVolume(ftxui::ScreenInteractive& screen, std::shared_ptr<Minesweeper::VolumeBoard>& volume) {
+    namespace tui = ftxui;
+    using Minesweeper::SliceComponentBase, Minesweeper::SliceComponent, Minesweeper::VolumeBoard;
+    while (true) {
+        const SliceComponent slice{SliceComponentBase::Create(volume, screen.ExitLoopClosure())};
+        const tui::Component gameplayRender = Renderer(slice, [&] {
+            return tui::vbox({
+                       tui::text(std::format("Remaining mines: {}", volume->getRemainingMines())),
+                       tui::separator(),
+                       slice->Render()
+                   }) | tui::border | tui::center;
+        });
+        screen.Loop(gameplayRender);
+
+        const std::vector<std::string> endEntries{"Retry", "Exit"};
+        int endScreenSelection{-1};
+        const tui::Component endMenu = tui::Menu(&endEntries, &endScreenSelection,
+                                                 {.on_enter = screen.ExitLoopClosure()});
+        const tui::Element endMessage = volume->hitMine()
+                                            ? tui::text("You hit a mine! You lose!")
+                                            : tui::text("You cleared every safe tile! You win!");
+        const tui::Component endScreenRender = Renderer(endMenu, [&] {
+            return tui::vbox({
+                       slice->Render() | tui::border | tui::hcenter,
+                       endMessage | tui::hcenter,
+                       endMenu->Render() | tui::hcenter
+                   }) | tui::center;
+        });
+        screen.Loop(endScreenRender);
+        if (endScreenSelection != 0) {
+            return EXIT_SUCCESS;
+        }
+        volume = std::make_shared<VolumeBoard>(volume->getExtents(), volume->getMineCount());
+    }
+}
+
+int simulate(const SimulationSettings& settings) {
+    Minesweeper::Simulation simulation{settings.rowAmount, settings.columnAmount, settings.mineCount,
+                                       settings.threadAmount};
+    const Minesweeper::Simulation::Results results{simulation.run(settings.games)};
+    std::cout << std::format("Played {} {} games on {} threads in {:.2f} s\n", results.games, settings.difficulty,
+                             simulation.getThreadAmount(), std::chrono::duration<double>(results.elapsed).count());
+    std::cout << std::format("Win rate:    {:.2f}% ({} won)\n", 100.0 * results.winRate(), results.wins);
+    std::cout << std::format("Mean clicks: {:.1f}\n", results.meanClicks());
+    std::cout << std::format("3BV/s:       {:.0f}\n", results.threeBVPerSecond());
+    std::cout << std::format("Games/s:     {:.1f}\n", results.gamesPerSecond());
+    return EXIT_SUCCESS;
+}
+
+void parseArguments(const int argc, const char* const argv[], std::shared_ptr<Minesweeper::Board>& board,
+                    std::shared_ptr<Minesweeper::VolumeBoard>& volume, Minesweeper::CountMode& countMode,
+                    Minesweeper::RevealEngine& revealEngine, std::optional<SimulationSettings>& simulation) {
     argparse::ArgumentParser parser("minesweeper", "", argparse::default_arguments::help);
     parser.set_usage_max_line_width(80);
     parser.set_usage_break_on_mutex();
@@ -273,22 +362,69 @@ void parseArguments(const int argc, const char* const argv[], std::shared_ptr<Mi
     difficultyArguments.add_argument("--c", "--custom").help(
                            "Creates a ROW x COLUMN with MINES mines. ROW and COLUMN must be less than 256, and MINES cannot be equal to or greater than ROW * COLUMN.")
                        .metavar("ROW COLUMN MINES").nargs(3);
+    difficultyArguments.add_argument("--v", "--volume").help(
+                           "Creates an X x Y x Z three-dimensional board with MINES mines, played one layer at a time. X, Y and Z must be less than 65536, and MINES cannot be equal to or greater than X * Y * Z.")
+                       .metavar("X Y Z MINES").nargs(4);
+
+    parser.add_argument("--lazy-counts").help(
+        "Counts a tile's surrounding mines when it is first revealed instead of when the mines are placed.").flag();
+    parser.add_argument("--bit-parallel-reveal").help(
+        "Opens empty regions with whole-row bit operations instead of tile by tile on a thread pool.").flag();
+    parser.add_argument("--huge-pages").help(
+              "Sets how large boards are backed by huge pages: off (the default), transparent or hugetlb, which uses the reserved huge page pool when there is one.")
+          .metavar("MODE").choices("off", "transparent", "hugetlb").default_value(std::string{"off"});
+    parser.add_argument("--simulate").help(
+        "Lets the solver play N games without the TUI and prints its win rate, mean clicks, 3BV/s and games per second.")
+          .metavar("N").scan<'u', std::size_t>();
+    parser.add_argument("--difficulty").help("Sets the board --simulate plays on: beginner, intermediate or expert.")
+          .metavar("LEVEL").choices("beginner", "intermediate", "expert").default_value(std::string{"expert"});
+    parser.add_argument("--threads").help(
+              "Sets how many games --simulate plays at once, one board per thread. 0, the default, uses every core.")
+          .metavar("T").scan<'u', std::size_t>().default_value(std::size_t{0});
 
     parser.add_description("A Minesweeper instance you can play in your terminal.");
     parser.add_epilog("Providing no arguments will allow you to select the difficulty from the application itself.");
 
     try {
         parser.parse_args(argc, argv);
+        if (parser.get<bool>("--lazy-counts")) {
+            countMode = Minesweeper::CountMode::lazy;
+        }
+        if (parser.get<bool>("--bit-parallel-reveal")) {
+            revealEngine = Minesweeper::RevealEngine::bitParallel;
+        }
+        if (const auto hugePages{parser.get<std::string>("--huge-pages")}; hugePages == "transparent") {
+            Minesweeper::setHugePageMode(Minesweeper::HugePageMode::transparent);
+        } else if (hugePages == "hugetlb") {
+            Minesweeper::setHugePageMode(Minesweeper::HugePageMode::hugetlb);
+        }
+        if (parser.is_used("--simulate")) {
+            const auto difficulty{parser.get<std::string>("--difficulty")};
+            std::uint8_t rowAmount{16};
+            std::uint8_t columnAmount{30};
+            std::uint16_t mineCount{99};
+            if (difficulty == "beginner") {
+                rowAmount = 9;
+                columnAmount = 9;
+                mineCount = 10;
+            } else if (difficulty == "intermediate") {
+                columnAmount = 16;
+                mineCount = 40;
+            }
+            simulation = SimulationSettings{parser.get<std::size_t>("--simulate"), difficulty, rowAmount, columnAmount,
+                                            mineCount, parser.get<std::size_t>("--threads")};
+            return;
+        }
         if (parser.is_used("--b")) {
-            board = std::make_shared<Minesweeper::Board>(9, 9, 10);
+            board = std::make_shared<Minesweeper::Board>(9, 9, 10, countMode, revealEngine);
             return;
         }
         if (parser.is_used("--i")) {
-            board = std::make_shared<Minesweeper::Board>(16, 16, 40);
+            board = std::make_shared<Minesweeper::Board>(16, 16, 40, countMode, revealEngine);
             return;
         }
         if (parser.is_used("--e")) {
-            board = std::make_shared<Minesweeper::Board>(16, 30, 99);
+            board = std::make_shared<Minesweeper::Board>(16, 30, 99, countMode, revealEngine);
             return;
         }
         if (parser.is_used("--c")) {
@@ -346,7 +482,34 @@ void parseArguments(const int argc, const char* const argv[], std::shared_ptr<Mi
             validate(rowBigger, columnBigger, minesBigger);
             board = std::make_shared<Minesweeper::Board>(static_cast<std::uint8_t>(arguments[0]),
                                                          static_cast<std::uint8_t>(arguments[1]),
-                                                         static_cast<std::uint16_t>(arguments[2]));
+                                                         static_cast<std::uint16_t>(arguments[2]), countMode,
+                                                         revealEngine);
+        }
+        if (parser.is_used("--v")) {
+            const auto stringArguments{parser.get<std::vector<std::string> >("--v")};
+            std::array<unsigned long long, 4> arguments{};
+            std::ranges::transform(stringArguments, std::begin(arguments), [](const std::string& string) {
+                if (string.empty() || string.length() > std::numeric_limits<std::uint32_t>::digits10
+                    || !std::ranges::all_of(string, [](const unsigned char ch) { return std::isdigit(ch); })) {
+                    throw std::invalid_argument("Invalid usage. X, Y, Z, and MINES must all be a positive number");
+                }
+                return std::stoull(string);
+            });
+            const unsigned long long tileAmount{arguments[0] * arguments[1] * arguments[2]};
+            if (std::ranges::any_of(arguments, [](const unsigned long long argument) { return argument == 0; })
+                || std::ranges::any_of(arguments | std::views::take(3), [](const unsigned long long argument) {
+                    return argument > UINT16_MAX;
+                })
+                || tileAmount > UINT32_MAX || arguments[3] >= tileAmount) {
+                throw std::invalid_argument(
+                    "Invalid usage. X, Y, and Z must be between 1 and 65535, X * Y * Z must fit in 32 bits, and MINES must be less than X * Y * Z.");
+            }
+            volume = std::make_shared<Minesweeper::VolumeBoard>(
+                Minesweeper::VolumeBoard::Coordinates{
+                    static_cast<std::uint16_t>(arguments[0]), static_cast<std::uint16_t>(arguments[1]),
+                    static_cast<std::uint16_t>(arguments[2])
+                },
+                static_cast<std::uint32_t>(arguments[3]));
         }
     } catch (const std::exception& e) {
         std::cerr << e.what() << "\n";